@@ -0,0 +1,199 @@
+/**
+ * \file Alias_Table.h
+ * \date 17-Oct-2026
+ *
+ * \brief Alias_Table, O(1) sampling of an index with given weights (Walker's alias method,
+ * built with Vose's algorithm), and Discrete_Alias_Distribution, the same sampler with the
+ * interface of std::discrete_distribution.
+ *
+ * \details The n weights are normalized to an average of one and split into n columns of
+ * height one; column i keeps its own index with probability threshold[i] and otherwise yields
+ * alias[i]. A draw takes one 64-bit word: the high half selects the column (multiply-high by
+ * n), the low half is compared with the column's threshold (32 bits of resolution). A column
+ * is 8 bytes, so a table of a few hundred entries stays in L1.
+ * Weights must be non-negative with a positive sum, otherwise std::invalid_argument is thrown.
+ * The stream operators write the table itself, for checkpoints.
+ * Use cases are State (weighted transitions) and Distribution/Distribution_NTT with
+ * Discrete_Alias_Distribution as RANDOM_DIST, PARAM being std::vector<double> (the weights).
+ */
+
+#ifndef MONTECARLO_ALIAS_TABLE_H
+#define MONTECARLO_ALIAS_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+#include <val/montecarlo/Random_Engines.h>
+#include <val/montecarlo/Bulk_Uniform.h>
+
+class Alias_Table {
+    struct Column {
+        std::uint32_t threshold;    ///> keep the column's own index if the low word is below it
+        std::int32_t alias;         ///> index otherwise
+    };
+    std::vector<Column> columns;
+    std::vector<double> probabilities;  ///> normalized weights, as given
+
+public:
+
+    Alias_Table() = default;
+
+    /**
+     * Alias_Table constructor - Vose's algorithm, O(n).
+     * @param weights relative weights of the indices 0..n-1, non-negative with a positive sum
+     */
+    explicit Alias_Table(const std::vector<double>& weights) {
+        std::size_t n = weights.size();
+        double sum = 0.0;
+        for ( double w : weights ) {
+            if ( !(w >= 0.0) )
+                throw std::invalid_argument("Alias_Table: weights must be non-negative");
+            sum += w;
+        }
+        if ( n == 0 || !(sum > 0.0) || n > 0x7FFFFFFF )
+            throw std::invalid_argument("Alias_Table: weights must have a positive sum");
+
+        probabilities.resize(n);
+        std::vector<double> scaled(n);
+        std::vector<std::int32_t> small, large;
+        for ( std::size_t ix = 0; ix < n; ++ix ) {
+            probabilities[ix] = weights[ix] / sum;
+            scaled[ix] = probabilities[ix] * static_cast<double>(n);
+            (scaled[ix] < 1.0 ? small : large).push_back(static_cast<std::int32_t>(ix));
+        }
+        columns.resize(n);
+        while ( !small.empty() && !large.empty() ) {
+            std::int32_t lo = small.back();
+            small.pop_back();
+            std::int32_t hi = large.back();
+            columns[lo] = Column{static_cast<std::uint32_t>(scaled[lo] * 4294967296.0), hi};
+            scaled[hi] = (scaled[hi] + scaled[lo]) - 1.0;
+            if ( scaled[hi] < 1.0 ) {
+                large.pop_back();
+                small.push_back(hi);
+            }
+        }
+        // What is left is full up to rounding, it keeps its own index.
+        for ( std::int32_t ix : large )
+            columns[ix] = Column{0xFFFFFFFFu, ix};
+        for ( std::int32_t ix : small )
+            columns[ix] = Column{0xFFFFFFFFu, ix};
+    }
+
+    /**
+     * sample - an index drawn with the weights, from one 64-bit word.
+     */
+    template <class URBG>
+    int operator()(URBG& dre) const {
+        std::uint64_t word = random_word(dre);
+        std::uint32_t column = static_cast<std::uint32_t>(((word >> 32) * columns.size()) >> 32);
+        const Column& c = columns[column];
+        // Select without a branch, the outcome is as unpredictable as the draw itself.
+        std::int32_t use_alias = -static_cast<std::int32_t>(static_cast<std::uint32_t>(word) >= c.threshold);
+        return static_cast<int>(column) ^ ((static_cast<int>(column) ^ c.alias) & use_alias);
+    }
+
+    std::size_t size() const { return columns.size(); }
+    bool empty() const { return columns.empty(); }
+
+    /**
+     * get_probabilities - the normalized weights.
+     */
+    const std::vector<double>& get_probabilities() const { return probabilities; }
+
+    /**
+     * stream operators - the size, then the probability, threshold and alias of each column. The
+     * table is written as built rather than rebuilt from the probabilities on reading, so that a
+     * checkpointed run draws the same values after resuming.
+     */
+    friend std::ostream& operator<<(std::ostream& o, const Alias_Table& table) {
+        std::ios_base::fmtflags flags = o.flags(std::ios_base::scientific);
+        std::streamsize precision = o.precision(std::numeric_limits<double>::max_digits10);
+        o << table.columns.size();
+        for ( std::size_t ix = 0; ix < table.columns.size(); ++ix )
+            o << ' ' << table.probabilities[ix] << ' ' << table.columns[ix].threshold << ' ' << table.columns[ix].alias;
+        o.flags(flags);
+        o.precision(precision);
+        return o;
+    }
+
+    friend std::istream& operator>>(std::istream& i, Alias_Table& table) {
+        std::size_t n = 0;
+        if ( !(i >> n) )
+            return i;
+        std::vector<Column> columns(n);
+        std::vector<double> probabilities(n);
+        for ( std::size_t ix = 0; ix < n; ++ix ) {
+            i >> probabilities[ix] >> columns[ix].threshold >> columns[ix].alias;
+            if ( i && (columns[ix].alias < 0 || static_cast<std::size_t>(columns[ix].alias) >= n) )
+                i.setstate(std::ios_base::failbit);
+        }
+        if ( i ) {
+            table.columns = std::move(columns);
+            table.probabilities = std::move(probabilities);
+        }
+        return i;
+    }
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * Discrete_Alias_Distribution - values 0..n-1 with probabilities proportional to the weights,
+ * as std::discrete_distribution but O(1) per value whatever n is. The values differ from those
+ * of std::discrete_distribution for the same engine (the distribution is the same).
+ * @tparam IntType - integral type of the values
+ */
+template <class IntType = int>
+class Discrete_Alias_Distribution {
+    Alias_Table table;
+public:
+    using result_type = IntType;
+
+    Discrete_Alias_Distribution() : table(std::vector<double>{1.0}) {}
+
+    explicit Discrete_Alias_Distribution(const std::vector<double>& weights) : table(weights) {}
+
+    Discrete_Alias_Distribution(std::initializer_list<double> weights) : table(std::vector<double>(weights)) {}
+
+    template <class ITERATOR>
+    Discrete_Alias_Distribution(ITERATOR first_weight, ITERATOR last_weight)
+            : table(std::vector<double>(first_weight, last_weight)) {}
+
+    template <class URBG>
+    result_type operator()(URBG& dre) const {
+        return static_cast<result_type>(table(dre));
+    }
+
+    std::vector<double> probabilities() const { return table.get_probabilities(); }
+    result_type min() const { return 0; }
+    result_type max() const { return static_cast<result_type>(table.size() - 1); }
+    void reset() {}
+
+    friend std::ostream& operator<<(std::ostream& o, const Discrete_Alias_Distribution& d) {
+        return o << d.table;
+    }
+
+    friend std::istream& operator>>(std::istream& i, Discrete_Alias_Distribution& d) {
+        return i >> d.table;
+    }
+};
+
+/**
+ * fill_distribution - bulk fill for Discrete_Alias_Distribution (see Bulk_Uniform.h).
+ */
+template <class T>
+void fill_distribution(Bulk_Uniform_Generator& generator, const Discrete_Alias_Distribution<T>& distribution,
+        T* out, std::size_t n) {
+    Bulk_Word_Stream words(generator);
+    for ( std::size_t ix = 0; ix < n; ++ix )
+        out[ix] = distribution(words);
+}
+
+#endif //MONTECARLO_ALIAS_TABLE_H
@@ -0,0 +1,168 @@
+/**
+ * \file Async_Run.h
+ * \date 17-Oct-2026
+ *
+ * \brief Async_Run, the handle of a simulation running on a background thread: trials done,
+ * current estimate and throughput at any moment, cooperative cancellation and a progress
+ * callback called at a fixed interval.
+ *
+ * \details The run proceeds in chunks of trials; between chunks it publishes the trials done
+ * and the running sum through atomics, tests the cancel flag and, if a callback is given and
+ * the interval has elapsed, calls it (on the run thread). Nothing is added inside the chunk,
+ * so with chunks of a few thousand trials the cost is a few atomic stores and a clock read per
+ * chunk. Progress can thus lag by at most one chunk, and a cancelled run stops at the end of
+ * the current chunk. An exception thrown by the run is rethrown by wait().
+ * Use case is MonteCarloSimulation::run_async.
+ */
+
+#ifndef MONTECARLO_ASYNC_RUN_H
+#define MONTECARLO_ASYNC_RUN_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+/**
+ * Run_Progress - a snapshot of an asynchronous run.
+ */
+struct Run_Progress {
+    std::uint64_t nr_trials_done = 0;
+    std::uint64_t nr_trials = 0;    ///> trials requested
+    double estimate = 0.0;          ///> result of the trials done so far
+    double seconds = 0.0;           ///> since the start of the run
+    bool finished = false;          ///> no more trials will be run (done, cancelled or failed)
+    bool cancelled = false;
+
+    double trials_per_second() const { return seconds > 0.0 ? static_cast<double>(nr_trials_done) / seconds : 0.0; }
+    double fraction_done() const { return nr_trials > 0 ? static_cast<double>(nr_trials_done) / static_cast<double>(nr_trials) : 1.0; }
+};
+
+using Progress_Callback = std::function<void(const Run_Progress&)>;
+
+/**
+ * Run_Status - state shared between the run thread and the handle.
+ */
+struct Run_Status {
+    std::uint64_t nr_trials;
+    std::chrono::steady_clock::time_point start;
+    std::atomic<std::uint64_t> nr_trials_done{0};
+    std::atomic<double> cumulative{0.0};    ///> running sum as double, for the estimate
+    std::atomic<bool> cancel_requested{false};
+    std::atomic<bool> finished{false};
+
+    explicit Run_Status(std::uint64_t _nr_trials) : nr_trials(_nr_trials), start(std::chrono::steady_clock::now()) {}
+
+    Run_Progress snapshot() const {
+        Run_Progress progress;
+        progress.finished = finished.load(std::memory_order_acquire);
+        progress.nr_trials_done = nr_trials_done.load(std::memory_order_acquire);
+        progress.nr_trials = nr_trials;
+        double sum = cumulative.load(std::memory_order_relaxed);
+        progress.estimate = progress.nr_trials_done > 0 ? sum / static_cast<double>(progress.nr_trials_done) : 0.0;
+        progress.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        progress.cancelled = cancel_requested.load(std::memory_order_relaxed) && progress.nr_trials_done < nr_trials;
+        return progress;
+    }
+};
+
+class Async_Run {
+    std::shared_ptr<Run_Status> status;
+    std::future<void> done;
+
+public:
+
+    Async_Run(std::shared_ptr<Run_Status> _status, std::future<void> _done)
+            : status(std::move(_status)), done(std::move(_done)) {}
+
+    Async_Run(Async_Run&&) = default;
+    Async_Run& operator=(Async_Run&&) = default;
+
+    /**
+     * destructor - waits for the run to finish (cancel() first to stop it early).
+     */
+    ~Async_Run() {
+        if ( done.valid() ) done.wait();
+    }
+
+    /**
+     * progress - trials done, estimate and throughput now; safe to call from any thread.
+     */
+    Run_Progress progress() const { return status->snapshot(); }
+
+    /**
+     * cancel - asks the run to stop after the current chunk; the simulation then holds the
+     * partial result (nr_trials is set to the trials done).
+     */
+    void cancel() { status->cancel_requested.store(true, std::memory_order_relaxed); }
+
+    bool is_finished() const { return status->finished.load(std::memory_order_acquire); }
+
+    /**
+     * wait - blocks until the run has finished and returns its final progress; rethrows an
+     * exception of the run. Call once.
+     */
+    Run_Progress wait() {
+        done.get();
+        return status->snapshot();
+    }
+
+    template <class REP, class PERIOD>
+    bool wait_for(std::chrono::duration<REP, PERIOD> timeout) const {
+        return done.wait_for(timeout) == std::future_status::ready;
+    }
+};
+
+/**
+ * launch_async_run - runs nr_trials in chunks on a new thread.
+ * @param nr_trials trials requested
+ * @param chunk_trials trials between two publications of the progress, at least one
+ * (std::invalid_argument is thrown otherwise, before anything is launched)
+ * @param interval minimum time between two calls of callback
+ * @param callback called on the run thread with the progress, may be empty
+ * @param run_chunk callable as double(int count): runs count more trials and returns the
+ * cumulative value so far
+ * @param stop callable as void(std::uint64_t nr_trials_done), called on the run thread once
+ * no more trials will be run
+ */
+template <class RUN_CHUNK, class STOP>
+Async_Run launch_async_run(std::uint64_t nr_trials, int chunk_trials, std::chrono::milliseconds interval,
+        Progress_Callback callback, RUN_CHUNK run_chunk, STOP stop) {
+    if ( chunk_trials < 1 )
+        throw std::invalid_argument("launch_async_run: a chunk must hold at least one trial");
+    auto status = std::make_shared<Run_Status>(nr_trials);
+    std::future<void> done = std::async(std::launch::async,
+            [status, chunk_trials, interval, callback = std::move(callback), run_chunk, stop]() mutable {
+        auto next_callback = status->start + interval;
+        std::uint64_t ix = 0;
+        try {
+            while ( ix < status->nr_trials && !status->cancel_requested.load(std::memory_order_relaxed) ) {
+                int count = static_cast<int>(std::min<std::uint64_t>(chunk_trials, status->nr_trials - ix));
+                double cumulative = run_chunk(count);
+                ix += count;
+                status->cumulative.store(cumulative, std::memory_order_relaxed);
+                status->nr_trials_done.store(ix, std::memory_order_release);
+                if ( callback && std::chrono::steady_clock::now() >= next_callback ) {
+                    callback(status->snapshot());
+                    next_callback = std::chrono::steady_clock::now() + interval;
+                }
+            }
+        }
+        catch (...) {
+            stop(ix);
+            status->finished.store(true, std::memory_order_release);
+            throw;
+        }
+        stop(ix);
+        status->finished.store(true, std::memory_order_release);
+        if ( callback ) callback(status->snapshot());
+    });
+    return Async_Run(std::move(status), std::move(done));
+}
+
+#endif //MONTECARLO_ASYNC_RUN_H
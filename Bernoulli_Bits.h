@@ -0,0 +1,237 @@
+/**
+ * \file Bernoulli_Bits.h
+ * \date 17-Oct-2026
+ *
+ * \brief Bernoulli_Bits, a bit-packed store of Bernoulli events (coin flips), generated 64 at a
+ * time, with popcount sums and run-length queries.
+ *
+ * \details The probability of 1 is held as a 64-bit binary fraction p = threshold / 2^64
+ * (exact for numerator/denominator with a power of two denominator up to 2^64, otherwise the
+ * nearest such fraction below). 64 flips are decided together by comparing 64 uniform binary
+ * fractions with p, one bit position (one random word) at a time from the most significant:
+ * a lane is decided as soon as its bit differs from that of p, so p = 1/2 takes one word per
+ * 64 flips, p = k/2^n at most n words, and any other p some 8 words on average.
+ * The events are 64 to a word, so a trial of a million flips is 16 KB instead of 8 MB in a
+ * deque of int, sum() is one popcount per word and runs are found with count-trailing-zeros.
+ * Use case is Distribution<T, DistributionType::BernoulliPacked> in Distribution_alpha.h and
+ * Distribution.h.
+ */
+
+#ifndef MONTECARLO_BERNOULLI_BITS_H
+#define MONTECARLO_BERNOULLI_BITS_H
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <val/montecarlo/Random_Engines.h>
+
+class Bernoulli_Bits {
+    std::vector<std::uint64_t> words;
+    std::size_t nr_events;
+    std::uint64_t threshold;    ///> p * 2^64
+    bool always;                ///> p == 1, which threshold cannot hold
+
+    /**
+     * tail_mask - valid bits of the last word.
+     */
+    std::uint64_t tail_mask() const {
+        std::size_t tail = nr_events % 64;
+        return tail == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << tail) - 1;
+    }
+
+    /**
+     * for_each_run - calls on_run(length) for every maximal run of events equal to value.
+     */
+    template <class ON_RUN>
+    void for_each_run(bool value, ON_RUN on_run) const {
+        std::size_t current = 0;
+        for ( std::size_t wx = 0; wx < words.size(); ++wx ) {
+            std::uint64_t x = value ? words[wx] : ~words[wx];
+            int valid = wx + 1 == words.size() && nr_events % 64 != 0 ? static_cast<int>(nr_events % 64) : 64;
+            int pos = 0;
+            while ( pos < valid ) {
+                std::uint64_t rest = x >> pos;
+                if ( rest & 1 ) {
+                    int ones = std::min(std::countr_one(rest), valid - pos);
+                    current += ones;
+                    pos += ones;
+                }
+                else {
+                    if ( current > 0 ) {
+                        on_run(current);
+                        current = 0;
+                    }
+                    pos += std::min(std::countr_zero(rest), valid - pos);
+                }
+            }
+        }
+        if ( current > 0 )
+            on_run(current);
+    }
+
+public:
+
+    /**
+     * Bernoulli_Bits constructor
+     * @param probability_of_true in [0, 1]
+     * @param _nr_events number of flips, all 0 until loaded
+     */
+    Bernoulli_Bits(double probability_of_true, std::size_t _nr_events)
+            : words((_nr_events + 63) / 64, 0), nr_events(_nr_events),
+              threshold(0), always(probability_of_true >= 1.0) {
+        if ( !(probability_of_true >= 0.0 && probability_of_true <= 1.0) )
+            throw std::invalid_argument("Bernoulli_Bits: probability must be in [0, 1]");
+        if ( !always ) {
+            double scaled = std::ldexp(probability_of_true, 64);
+            threshold = scaled >= 18446744073709551615.0 ? ~std::uint64_t(0) : static_cast<std::uint64_t>(scaled);
+        }
+    }
+
+    /**
+     * Bernoulli_Bits constructor - probability numerator / denominator, exact when denominator is
+     * a power of two.
+     */
+    Bernoulli_Bits(std::uint64_t numerator, std::uint64_t denominator, std::size_t _nr_events)
+            : words((_nr_events + 63) / 64, 0), nr_events(_nr_events),
+              threshold(0), always(denominator != 0 && numerator >= denominator) {
+        if ( denominator == 0 || numerator > denominator )
+            throw std::invalid_argument("Bernoulli_Bits: probability must be in [0, 1]");
+        if ( !always )
+            threshold = static_cast<std::uint64_t>((static_cast<unsigned __int128>(numerator) << 64) / denominator);
+    }
+
+    /**
+     * flip_64 - 64 independent flips, bit i being 1 with probability p.
+     */
+    template <class URBG>
+    std::uint64_t flip_64(URBG& dre) const {
+        if ( always ) return ~std::uint64_t(0);
+        std::uint64_t result = 0;
+        std::uint64_t undecided = ~std::uint64_t(0);
+        int lowest = threshold == 0 ? 64 : std::countr_zero(threshold);
+        for ( int bit = 63; bit >= lowest && undecided != 0; --bit ) {
+            std::uint64_t r = random_word(dre);
+            if ( (threshold >> bit) & 1 ) {
+                result |= undecided & ~r;   ///> a 0 where p has a 1: below p
+                undecided &= r;
+            }
+            else
+                undecided &= ~r;            ///> a 1 where p has a 0: above p
+        }
+        return result;      ///> lanes still undecided equal p so far, with nothing left: not below p
+    }
+
+    /**
+     * reload_random_values - draws all events, 64 per flip_64.
+     */
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
+        for ( std::uint64_t& word : words )
+            word = flip_64(dre);
+        if ( !words.empty() )
+            words.back() &= tail_mask();
+    }
+
+    /**
+     * reload_random_value - draws the event at index alone, from one random word.
+     */
+    template <class URBG>
+    void reload_random_value(std::size_t index, URBG& dre) {
+        set(index, always || random_word(dre) < threshold);
+    }
+
+    int operator[](std::size_t index) const { return static_cast<int>((words[index / 64] >> (index % 64)) & 1); }
+
+    void set(std::size_t index, bool value) {
+        std::uint64_t bit = std::uint64_t(1) << (index % 64);
+        words[index / 64] = value ? words[index / 64] | bit : words[index / 64] & ~bit;
+    }
+
+    std::size_t size() const { return nr_events; }
+
+    /**
+     * data - the packed events, event i being bit i % 64 of word i / 64; the unused bits of the
+     * last word are zero.
+     */
+    const std::uint64_t* data() const { return words.data(); }
+    std::size_t nr_words() const { return words.size(); }
+
+    double probability() const { return always ? 1.0 : std::ldexp(static_cast<double>(threshold), -64); }
+
+    /**
+     * sum - number of events equal to 1.
+     */
+    std::size_t sum() const {
+        std::size_t total = 0;
+        for ( std::uint64_t word : words )
+            total += static_cast<std::size_t>(std::popcount(word));
+        return total;
+    }
+
+    /**
+     * count_ones - number of events equal to 1 in [first, last).
+     */
+    std::size_t count_ones(std::size_t first, std::size_t last) const {
+        if ( first >= last ) return 0;
+        std::size_t first_word = first / 64, last_word = (last - 1) / 64;
+        std::uint64_t first_mask = ~std::uint64_t(0) << (first % 64);
+        std::uint64_t last_mask = last % 64 == 0 ? ~std::uint64_t(0) : (std::uint64_t(1) << (last % 64)) - 1;
+        if ( first_word == last_word )
+            return static_cast<std::size_t>(std::popcount(words[first_word] & first_mask & last_mask));
+        std::size_t total = static_cast<std::size_t>(std::popcount(words[first_word] & first_mask));
+        for ( std::size_t wx = first_word + 1; wx < last_word; ++wx )
+            total += static_cast<std::size_t>(std::popcount(words[wx]));
+        return total + static_cast<std::size_t>(std::popcount(words[last_word] & last_mask));
+    }
+
+    /**
+     * longest_run - length of the longest run of events equal to value (e.g., most heads in a row).
+     */
+    std::size_t longest_run(bool value = true) const {
+        std::size_t longest = 0;
+        for_each_run(value, [&longest](std::size_t length) { longest = std::max(longest, length); });
+        return longest;
+    }
+
+    /**
+     * count_runs - number of maximal runs of events equal to value of at least min_length.
+     */
+    std::size_t count_runs(std::size_t min_length = 1, bool value = true) const {
+        std::size_t count = 0;
+        for_each_run(value, [&count, min_length](std::size_t length) { if ( length >= min_length ) ++count; });
+        return count;
+    }
+
+    /**
+     * const_iterator - the events as int (0 or 1), so that range-for loops written for the
+     * deque of int of BernoulliIntegral still work.
+     */
+    class const_iterator {
+        const Bernoulli_Bits* bits;
+        std::size_t index;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = int;
+
+        const_iterator() : bits(nullptr), index(0) {}
+        const_iterator(const Bernoulli_Bits* _bits, std::size_t _index) : bits(_bits), index(_index) {}
+
+        int operator*() const { return (*bits)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator previous = *this; ++index; return previous; }
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.index == b.index; }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, nr_events); }
+};
+
+#endif //MONTECARLO_BERNOULLI_BITS_H
@@ -0,0 +1,242 @@
+/**
+ * \file Bulk_Uniform.h
+ * \date 17-Oct-2026
+ *
+ * \brief Bulk_Uniform_Generator, fills whole arrays with uniform random values from four
+ * interleaved xoshiro256** lanes, with an AVX2 path selected at run time.
+ *
+ * \details The four lanes are one Xoshiro256StarStar seeded from the seed and jumped by
+ * 2^128 between lanes, so their streams do not overlap. Output word 4i+k is the i-th
+ * output of lane k on both the AVX2 and the scalar path, i.e., the values do not depend on
+ * the host the binary runs on. The AVX2 code is compiled with a function target attribute
+ * and chosen with __builtin_cpu_supports, so one binary runs on hosts with and without
+ * AVX2 (and on other architectures the scalar path is the only one compiled).
+ * Reals are formed from the top 52 bits of a word (exponent trick, no conversion), integers
+ * by multiply-high of the word with the width of the range (Lemire, bias below width/2^64).
+ * Use case is Distribution::reload_random_values_bulk and load_batch_bulk.
+ */
+
+#ifndef MONTECARLO_BULK_UNIFORM_H
+#define MONTECARLO_BULK_UNIFORM_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <val/montecarlo/Random_Engines.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MONTECARLO_BULK_UNIFORM_AVX2 1
+#include <immintrin.h>
+#endif
+
+class Bulk_Uniform_Generator {
+public:
+    static constexpr int nr_lanes = 4;
+
+private:
+    alignas(32) std::array<std::array<std::uint64_t, nr_lanes>, 4> s; ///> s[word][lane], structure of arrays
+    bool simd;  ///> use the AVX2 path
+
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    /**
+     * fill_scalar - nr_steps steps of the four lanes, 4*nr_steps words.
+     */
+    void fill_scalar(std::uint64_t* out, std::size_t nr_steps) {
+        for ( std::size_t ix = 0; ix < nr_steps; ++ix )
+            for ( int lx = 0; lx < nr_lanes; ++lx ) {
+                out[ix * nr_lanes + lx] = rotl(s[1][lx] * 5, 7) * 9;
+                std::uint64_t t = s[1][lx] << 17;
+                s[2][lx] ^= s[0][lx];
+                s[3][lx] ^= s[1][lx];
+                s[1][lx] ^= s[2][lx];
+                s[0][lx] ^= s[3][lx];
+                s[2][lx] ^= t;
+                s[3][lx] = rotl(s[3][lx], 45);
+            }
+    }
+
+#ifdef MONTECARLO_BULK_UNIFORM_AVX2
+    __attribute__((target("avx2")))
+    void fill_avx2(std::uint64_t* out, std::size_t nr_steps) {
+        __m256i s0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[0].data()));
+        __m256i s1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[1].data()));
+        __m256i s2 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[2].data()));
+        __m256i s3 = _mm256_load_si256(reinterpret_cast<const __m256i*>(s[3].data()));
+        for ( std::size_t ix = 0; ix < nr_steps; ++ix ) {
+            __m256i times5 = _mm256_add_epi64(_mm256_slli_epi64(s1, 2), s1);
+            __m256i rotated = _mm256_or_si256(_mm256_slli_epi64(times5, 7), _mm256_srli_epi64(times5, 57));
+            __m256i result = _mm256_add_epi64(_mm256_slli_epi64(rotated, 3), rotated);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + ix * nr_lanes), result);
+            __m256i t = _mm256_slli_epi64(s1, 17);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s[0].data()), s0);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s[1].data()), s1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s[2].data()), s2);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(s[3].data()), s3);
+    }
+#endif
+
+    void fill_steps(std::uint64_t* out, std::size_t nr_steps) {
+#ifdef MONTECARLO_BULK_UNIFORM_AVX2
+        if ( simd ) {
+            fill_avx2(out, nr_steps);
+            return;
+        }
+#endif
+        fill_scalar(out, nr_steps);
+    }
+
+public:
+
+    /**
+     * Bulk_Uniform_Generator constructor
+     * @param seed expanded by splitmix64 into the state of the first lane
+     */
+    explicit Bulk_Uniform_Generator(std::uint64_t seed = 1) : simd(simd_supported()) {
+        Xoshiro256StarStar lane(seed);
+        for ( int lx = 0; lx < nr_lanes; ++lx ) {
+            for ( int wx = 0; wx < 4; ++wx )
+                s[wx][lx] = lane.state()[wx];
+            lane.jump();
+        }
+    }
+
+    /**
+     * simd_supported - whether this host can run the AVX2 path.
+     */
+    static bool simd_supported() {
+#ifdef MONTECARLO_BULK_UNIFORM_AVX2
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * use_simd - forces the scalar path (false) or returns to the AVX2 path if supported (true);
+     * both give the same values.
+     */
+    void use_simd(bool _simd) { simd = _simd && simd_supported(); }
+    bool uses_simd() const { return simd; }
+
+    /**
+     * fill_bits - n uniformly distributed 64-bit words. A tail of n % 4 words consumes a whole
+     * step of the four lanes.
+     */
+    void fill_bits(std::uint64_t* out, std::size_t n) {
+        std::size_t nr_steps = n / nr_lanes;
+        fill_steps(out, nr_steps);
+        std::size_t tail = n - nr_steps * nr_lanes;
+        if ( tail > 0 ) {
+            std::uint64_t last_step[nr_lanes];
+            fill_steps(last_step, 1);
+            std::memcpy(out + nr_steps * nr_lanes, last_step, tail * sizeof(std::uint64_t));
+        }
+    }
+
+    /**
+     * fill_uniform_real - n values uniform on [lb, ub) with 52 random bits each.
+     */
+    void fill_uniform_real(double* out, std::size_t n, double lb, double ub) {
+        std::uint64_t buffer[256];
+        double width = ub - lb;
+        for ( std::size_t first = 0; first < n; first += 256 ) {
+            std::size_t count = n - first < 256 ? n - first : 256;
+            fill_bits(buffer, count);
+            for ( std::size_t ix = 0; ix < count; ++ix ) {
+                std::uint64_t bits = (buffer[ix] >> 12) | 0x3FF0000000000000ULL; ///> a double in [1, 2)
+                double one_to_two;
+                std::memcpy(&one_to_two, &bits, sizeof(bits));
+                out[first + ix] = lb + (one_to_two - 1.0) * width;
+            }
+        }
+    }
+
+    void fill_uniform_real(float* out, std::size_t n, float lb, float ub) {
+        std::uint64_t buffer[256];
+        for ( std::size_t first = 0; first < n; first += 256 ) {
+            std::size_t count = n - first < 256 ? n - first : 256;
+            fill_bits(buffer, count);
+            for ( std::size_t ix = 0; ix < count; ++ix )
+                out[first + ix] = lb + static_cast<float>(buffer[ix] >> 40) * (1.0f / 16777216.0f) * (ub - lb);
+        }
+    }
+
+    /**
+     * fill_uniform_int - n values uniform on [min, max] (both inclusive).
+     */
+    template <class T>
+    void fill_uniform_int(T* out, std::size_t n, T min, T max) {
+        static_assert(std::is_integral_v<T>);
+        std::uint64_t width = static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min) + 1;
+        std::uint64_t buffer[256];
+        for ( std::size_t first = 0; first < n; first += 256 ) {
+            std::size_t count = n - first < 256 ? n - first : 256;
+            fill_bits(buffer, count);
+            for ( std::size_t ix = 0; ix < count; ++ix ) {
+                std::uint64_t offset = width == 0 ? buffer[ix]  ///> full 64-bit range
+                        : static_cast<std::uint64_t>((static_cast<unsigned __int128>(buffer[ix]) * width) >> 64);
+                out[first + ix] = static_cast<T>(static_cast<std::uint64_t>(min) + offset);
+            }
+        }
+    }
+};
+
+/**
+ * Bulk_Word_Stream - a 64-bit URBG reading the words of a Bulk_Uniform_Generator from a buffer
+ * refilled 256 words at a time, for the bulk fills of distributions that draw whole words
+ * (Ziggurat.h, Alias_Table.h).
+ */
+class Bulk_Word_Stream {
+    static constexpr std::size_t buffer_words = 256;
+
+    Bulk_Uniform_Generator& generator;
+    std::array<std::uint64_t, buffer_words> buffer;
+    std::size_t next;
+public:
+    using result_type = std::uint64_t;
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<std::uint64_t>::max(); }
+
+    explicit Bulk_Word_Stream(Bulk_Uniform_Generator& _generator) : generator(_generator), next(buffer_words) {}
+
+    result_type operator()() {
+        if ( next == buffer_words ) {
+            generator.fill_bits(buffer.data(), buffer_words);
+            next = 0;
+        }
+        return buffer[next++];
+    }
+};
+
+/**
+ * fill_distribution - bulk fill for the uniform distributions of <random> with the parameters of
+ * the distribution; other distributions have no bulk path.
+ */
+template <class T>
+void fill_distribution(Bulk_Uniform_Generator& generator, const std::uniform_real_distribution<T>& distribution,
+        T* out, std::size_t n) {
+    generator.fill_uniform_real(out, n, distribution.a(), distribution.b());
+}
+
+template <class T>
+void fill_distribution(Bulk_Uniform_Generator& generator, const std::uniform_int_distribution<T>& distribution,
+        T* out, std::size_t n) {
+    generator.fill_uniform_int(out, n, distribution.a(), distribution.b());
+}
+
+#endif //MONTECARLO_BULK_UNIFORM_H
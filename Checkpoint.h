@@ -0,0 +1,161 @@
+/**
+ * \file Checkpoint.h
+ * \date 17-Oct-2026
+ *
+ * \brief Checkpoint class, saves the state of a running simulation to a compact binary
+ * file at a fixed interval of trials so that an interrupted run can be resumed.
+ *
+ * \details The simulation engines (MonteCarloSimulation::run_with_checkpoints,
+ * StateMatrix::run_with_checkpoints) write their own state (trial index, cumulative and
+ * interim values, random engine, distribution) through the save/load callbacks; anything
+ * else that is filled during the run, typically a Histogram captured by condition_met, is
+ * attached to the Checkpoint and saved along with it. Random engines and standard library
+ * distributions are stored through their stream operators, which round-trip their state
+ * exactly, so a resumed run gives the identical result of an uninterrupted one.
+ * The file is first written next to its destination and then renamed over it, so a
+ * preemption while saving leaves the previous checkpoint intact.
+ */
+
+#ifndef MONTECARLO_CHECKPOINT_H
+#define MONTECARLO_CHECKPOINT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <val/montecarlo/Histogram.h>
+
+/**
+ * write_binary - writes the object representation of a trivially copyable value.
+ */
+template <class T>
+void write_binary(std::ostream& o, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "write_binary needs a trivially copyable type");
+    o.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <class T>
+void read_binary(std::istream& i, T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "read_binary needs a trivially copyable type");
+    i.read(reinterpret_cast<char*>(&value), sizeof(T));
+}
+
+/**
+ * write_stream_state - writes the state of an object that has a stream output operator (random
+ * engines and distributions) as a length-prefixed string.
+ */
+template <class T>
+void write_stream_state(std::ostream& o, const T& object) {
+    std::ostringstream text;
+    text << object;
+    std::string state = text.str();
+    write_binary(o, static_cast<std::uint64_t>(state.size()));
+    o.write(state.data(), static_cast<std::streamsize>(state.size()));
+}
+
+template <class T>
+void read_stream_state(std::istream& i, T& object) {
+    std::uint64_t size = 0;
+    read_binary(i, size);
+    std::string state(size, '\0');
+    i.read(state.data(), static_cast<std::streamsize>(size));
+    std::istringstream text(state);
+    text >> object;
+}
+
+class Checkpoint {
+    static constexpr std::uint32_t magic = 0x4b43434d; ///> "MCCK"
+    static constexpr std::uint32_t version = 1;
+
+    std::string path;   ///> checkpoint file
+    int interval;       ///> number of trials between two saves
+    std::vector<std::function<void(std::ostream&)>> savers;   ///> attached objects
+    std::vector<std::function<void(std::istream&)>> loaders;  ///> attached objects, same order
+
+public:
+
+    /**
+     * Checkpoint constructor
+     * @param _path checkpoint file, resumed from if it exists when the run starts
+     * @param _interval number of trials between two saves, at least one (std::invalid_argument
+     * is thrown otherwise)
+     */
+    Checkpoint(std::string _path, int _interval)
+            : path(std::move(_path)), interval(_interval) {
+        if ( interval < 1 )
+            throw std::invalid_argument("Checkpoint: the interval must be at least one trial");
+    }
+
+    /**
+     * attach - includes a histogram that is filled during the run in the checkpoint.
+     * @param histogram must outlive the run
+     */
+    template <class T, class U>
+    void attach(Histogram<T,U>& histogram) {
+        savers.push_back([&histogram](std::ostream& o) { histogram.write_binary(o); });
+        loaders.push_back([&histogram](std::istream& i) { histogram.read_binary(i); });
+    }
+
+    /**
+     * attach - includes any other object in the checkpoint through a pair of functions.
+     */
+    void attach(std::function<void(std::ostream&)> save, std::function<void(std::istream&)> load) {
+        savers.push_back(std::move(save));
+        loaders.push_back(std::move(load));
+    }
+
+    int get_interval() const { return interval; }
+
+    bool exists() const {
+        std::ifstream file(path, std::ios::binary);
+        return file.good();
+    }
+
+    /**
+     * save - writes the engine state (through save_engine) and the attached objects.
+     * @param save_engine callable as void(std::ostream&)
+     */
+    template <class SAVE_ENGINE>
+    void save(SAVE_ENGINE save_engine) {
+        std::string temporary_path = path + ".tmp";
+        {
+            std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+            write_binary(file, magic);
+            write_binary(file, version);
+            save_engine(file);
+            for ( auto& saver : savers )
+                saver(file);
+            file.flush();
+            if ( !file )
+                throw std::runtime_error("Checkpoint: cannot write " + temporary_path);
+        }
+        if ( std::rename(temporary_path.c_str(), path.c_str()) != 0 )
+            throw std::runtime_error("Checkpoint: cannot rename " + temporary_path + " to " + path);
+    }
+
+    /**
+     * load - reads back what save wrote.
+     * @param load_engine callable as void(std::istream&), mirror of the save_engine given to save
+     */
+    template <class LOAD_ENGINE>
+    void load(LOAD_ENGINE load_engine) {
+        std::ifstream file(path, std::ios::binary);
+        std::uint32_t file_magic = 0, file_version = 0;
+        read_binary(file, file_magic);
+        read_binary(file, file_version);
+        if ( !file || file_magic != magic || file_version != version )
+            throw std::runtime_error("Checkpoint: " + path + " is not a checkpoint file");
+        load_engine(file);
+        for ( auto& loader : loaders )
+            loader(file);
+        if ( !file )
+            throw std::runtime_error("Checkpoint: " + path + " is truncated");
+    }
+};
+
+#endif //MONTECARLO_CHECKPOINT_H
@@ -0,0 +1,223 @@
+/**
+ * \file Contiguous_Events.h
+ * \date 17-Oct-2026
+ *
+ * \brief Contiguous_Events, a container for the events of a Distribution that keeps them
+ * in one cache-line aligned block, as an alternative to std::deque.
+ *
+ * \details The subset of the deque interface used with events is supported (push_back,
+ * push_front, pop_back, pop_front, operator[], front, back, iterators, insert, erase,
+ * resize, clear) so that existing condition functions keep working when the
+ * Distribution's EVENTS template parameter is Contiguous_Events. Free space is kept at
+ * both ends of the block, so pushing to either end is amortized O(1) and does not
+ * allocate once the capacity has been reserved. Iterators are plain pointers, which lets
+ * the compiler vectorize loops over the events, and span() gives a std::span view for
+ * condition functions. Restricted to trivially copyable values (the arithmetic types of
+ * X_AXIS).
+ */
+
+#ifndef MONTECARLO_CONTIGUOUS_EVENTS_H
+#define MONTECARLO_CONTIGUOUS_EVENTS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <val/montecarlo/Event_Batch.h>
+
+template <class T>
+class Contiguous_Events {
+    static_assert(std::is_trivially_copyable_v<T>, "Contiguous_Events holds trivially copyable values");
+
+    T* block;               ///> aligned storage
+    std::size_t capacity;   ///> number of values block can hold
+    std::size_t first;      ///> index of the first value (free space before it)
+    std::size_t count;      ///> number of values
+
+    static T* allocate(std::size_t n) {
+        return n == 0 ? nullptr
+                      : static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(cache_line_size)));
+    }
+
+    static void deallocate(T* p) {
+        if ( p ) ::operator delete(p, std::align_val_t(cache_line_size));
+    }
+
+    /**
+     * relocate - moves the values into a new block with front free slots before them.
+     */
+    void relocate(std::size_t new_capacity, std::size_t front) {
+        T* new_block = allocate(new_capacity);
+        if ( count > 0 )
+            std::memcpy(new_block + front, block + first, count * sizeof(T));
+        deallocate(block);
+        block = new_block;
+        capacity = new_capacity;
+        first = front;
+    }
+
+    void grow_back(std::size_t needed) {
+        if ( first + count + needed <= capacity ) return;
+        std::size_t new_capacity = std::max({2 * capacity, first + count + needed, std::size_t(16)});
+        relocate(new_capacity, first);
+    }
+
+    void grow_front(std::size_t needed) {
+        if ( first >= needed ) return;
+        std::size_t front = std::max({count, needed, std::size_t(8)});
+        relocate(std::max(2 * capacity, front + count + (capacity - first - count)), front);
+    }
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    Contiguous_Events() : block(nullptr), capacity(0), first(0), count(0) {}
+
+    explicit Contiguous_Events(std::size_t n, const T& value = T())
+            : block(allocate(n)), capacity(n), first(0), count(n) {
+        std::fill(begin(), end(), value);
+    }
+
+    Contiguous_Events(std::initializer_list<T> values)
+            : block(allocate(values.size())), capacity(values.size()), first(0), count(values.size()) {
+        std::copy(values.begin(), values.end(), begin());
+    }
+
+    Contiguous_Events(const Contiguous_Events& other)
+            : block(allocate(other.capacity)), capacity(other.capacity), first(other.first), count(other.count) {
+        if ( count > 0 )
+            std::memcpy(block + first, other.block + other.first, count * sizeof(T));
+    }
+
+    Contiguous_Events(Contiguous_Events&& other) noexcept
+            : block(other.block), capacity(other.capacity), first(other.first), count(other.count) {
+        other.block = nullptr;
+        other.capacity = other.first = other.count = 0;
+    }
+
+    Contiguous_Events& operator=(Contiguous_Events other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    ~Contiguous_Events() { deallocate(block); }
+
+    void swap(Contiguous_Events& other) noexcept {
+        std::swap(block, other.block);
+        std::swap(capacity, other.capacity);
+        std::swap(first, other.first);
+        std::swap(count, other.count);
+    }
+
+    /**
+     * reserve - makes room for n values at the back and front_slots at the front without
+     * further allocation.
+     */
+    void reserve(std::size_t n, std::size_t front_slots = 0) {
+        if ( first >= front_slots && first + n <= capacity ) return;
+        relocate(std::max(n, count) + front_slots, front_slots);
+    }
+
+    iterator begin() { return block + first; }
+    iterator end() { return block + first + count; }
+    const_iterator begin() const { return block + first; }
+    const_iterator end() const { return block + first + count; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    T* data() { return begin(); }
+    const T* data() const { return begin(); }
+    std::span<T> span() { return std::span<T>(begin(), count); }
+    std::span<const T> span() const { return std::span<const T>(begin(), count); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    T& operator[](std::size_t ix) { return block[first + ix]; }
+    const T& operator[](std::size_t ix) const { return block[first + ix]; }
+
+    T& at(std::size_t ix) {
+        if ( ix >= count ) throw std::out_of_range("Contiguous_Events::at");
+        return block[first + ix];
+    }
+
+    T& front() { return block[first]; }
+    T& back() { return block[first + count - 1]; }
+    const T& front() const { return block[first]; }
+    const T& back() const { return block[first + count - 1]; }
+
+    void push_back(const T& value) {
+        grow_back(1);
+        block[first + count++] = value;
+    }
+
+    void emplace_back(const T& value) { push_back(value); }
+
+    void push_front(const T& value) {
+        grow_front(1);
+        block[--first] = value;
+        ++count;
+    }
+
+    void emplace_front(const T& value) { push_front(value); }
+
+    void pop_back() { --count; }
+
+    void pop_front() {
+        ++first;
+        --count;
+    }
+
+    void clear() {
+        first = std::min(first, capacity / 4);  ///> keep some of the free front space
+        count = 0;
+    }
+
+    void resize(std::size_t n, const T& value = T()) {
+        if ( n > count ) {
+            grow_back(n - count);
+            std::fill(block + first + count, block + first + n, value);
+        }
+        count = n;
+    }
+
+    iterator insert(const_iterator position, const T& value) {
+        std::size_t offset = static_cast<std::size_t>(position - begin());
+        grow_back(1);
+        T* p = begin() + offset;
+        std::memmove(p + 1, p, (count - offset) * sizeof(T));
+        *p = value;
+        ++count;
+        return p;
+    }
+
+    iterator erase(const_iterator position) {
+        return erase(position, position + 1);
+    }
+
+    iterator erase(const_iterator from, const_iterator to) {
+        T* p = begin() + (from - begin());
+        std::size_t removed = static_cast<std::size_t>(to - from);
+        std::memmove(p, p + removed, static_cast<std::size_t>(end() - to) * sizeof(T));
+        count -= removed;
+        return p;
+    }
+
+    friend bool operator==(const Contiguous_Events& a, const Contiguous_Events& b) {
+        return std::equal(a.begin(), a.end(), b.begin(), b.end());
+    }
+};
+
+#endif //MONTECARLO_CONTIGUOUS_EVENTS_H
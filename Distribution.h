@@ -16,6 +16,8 @@
 #include <deque>
 #include <random>
 #include <algorithm>
+#include <val/montecarlo/Contiguous_Events.h>
+#include <val/montecarlo/Bernoulli_Bits.h>
 
 /**
  * DistributionType enum class
@@ -28,12 +30,15 @@
  *      NOTE: The prior statement is currently not applicable because of
  *      changing over to a deque as the basic structure for multiple events.
  *      It appears to have little effect on performance...
+ * - BernoulliPacked: as BernoulliIntegral, with the events packed 64 to a word and generated 64
+ *      at a time (see Bernoulli_Bits.h); events is a Bernoulli_Bits whatever EVENTS is
  */
 enum class DistributionType {
     VoidDistribution,
     UniformIntegral,
     UniformReal,
-    BernoulliIntegral
+    BernoulliIntegral,
+    BernoulliPacked
 };
 
 enum class Structure {
@@ -46,8 +51,9 @@ enum class Structure {
 /**
  * Primary template, note it has VoidDistribution as the default DistributionType.
  * @tparam T
+ * @tparam EVENTS container of the events, std::deque by default or Contiguous_Events
  */
-template <class T, DistributionType = DistributionType::VoidDistribution>
+template <class T, DistributionType = DistributionType::VoidDistribution, class EVENTS = std::deque<T>>
 class Distribution {};
 
 /**
@@ -55,8 +61,8 @@ class Distribution {};
  * Distribution of Uniform Integral values
  * @tparam T should be an integral type (other than bool)
  */
-template <class T>
-class Distribution <T, DistributionType::UniformIntegral> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::UniformIntegral, EVENTS> {
     std::default_random_engine dre;
     std::uniform_int_distribution<T> randomDistribution;
     int nr_events;
@@ -113,7 +119,7 @@ public:
         return cumulative;
     }
 
-    std::deque<T> events;
+    EVENTS events;
 };
 
 /**
@@ -121,8 +127,8 @@ public:
  * Distribution of Uniform Floating Point values
  * @tparam T should be an floating point type
  */
-template <class T>
-class Distribution <T, DistributionType::UniformReal> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::UniformReal, EVENTS> {
     std::default_random_engine dre;
     std::uniform_real_distribution<T> randomDistribution;
     int nr_events;
@@ -166,7 +172,7 @@ public:
         return cumulative;
     }
 
-    std::deque<T> events;
+    EVENTS events;
 };
 
 /**
@@ -178,8 +184,8 @@ public:
  *      NOTE: The prior statement is currently not applicable because of
  *      changing over to a deque as the basic structure for multiple events.
  */
-template <class T>
-class Distribution <T, DistributionType::BernoulliIntegral> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::BernoulliIntegral, EVENTS> {
     std::default_random_engine dre;
     std::bernoulli_distribution randomDistribution;
     int nr_events;
@@ -230,7 +236,52 @@ public:
         events.push_back(randomDistribution(dre));
     }
 
-    std::deque<T> events;
+    EVENTS events;
+};
+
+/**
+ * Template Specialization
+ * Distribution of Integral values restricted to two values, bit-packed (see Bernoulli_Bits.h)
+ * @tparam T unused, kept for the signature of the other specializations
+ */
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::BernoulliPacked, EVENTS> {
+    std::default_random_engine dre;
+public:
+    Bernoulli_Bits events;
+
+    /**
+     *
+     * @param _numerator Numerator of probability of 1 (true), exact if _denominator is a power of two
+     * @param _denominator Denominator of probability of 1 (true)
+     * @param _nr_events Number of sequential events to generated
+     * @param _seed Seed to be used by the random number generator (defaults to 1)
+     */
+    Distribution(T _numerator, T _denominator, int _nr_events, int _seed=1)
+            : dre(_seed),
+              events(static_cast<std::uint64_t>(_numerator), static_cast<std::uint64_t>(_denominator),
+                     static_cast<std::size_t>(_nr_events)) {
+        events.reload_random_values(dre);
+    }
+
+    /**
+     *
+     * @param probability_of_true Fixed type double representing probability of 1 (true)
+     * @param _nr_events Number of sequential events to generated
+     * @param _seed Seed to be used by the random number generator (defaults to 1)
+     */
+    Distribution(double probability_of_true, int _nr_events, int _seed=1)
+            : dre(_seed), events(probability_of_true, static_cast<std::size_t>(_nr_events)) {
+        events.reload_random_values(dre);
+    }
+
+    void reload_random_values() {
+        events.reload_random_values(dre);
+    }
+
+    void reload_random_value(int index) {
+        events.reload_random_value(static_cast<std::size_t>(index), dre);
+    }
 };
 
 #endif //MONTECARLO_DISTRIBUTION_H
@@ -14,6 +14,10 @@
 #include <deque>
 #include <random>
 #include <algorithm>
+#include <val/montecarlo/Contiguous_Events.h>
+#include <val/montecarlo/Ziggurat.h>
+#include <val/montecarlo/Bernoulli_Bits.h>
+#include <val/montecarlo/Fast_Poisson.h>
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -29,6 +33,11 @@
  *      NOTE: The prior statement is currently not applicable because of
  *      changing over to a deque as the basic structure for multiple events.
  *      It appears to have little effect on performance...
+ * - ZigguratExponentialReal, ZigguratNormalReal: exponential and normal values drawn with the
+ *      ziggurat method (see Ziggurat.h), much faster than ExponentialReal
+ * - BernoulliPacked: as BernoulliIntegral, with the events packed 64 to a word and generated 64
+ *      at a time (see Bernoulli_Bits.h); events is a Bernoulli_Bits whatever EVENTS is
+ * - FastPoissonIntegral: as PoissonIntegral, drawn from precomputed tables (see Fast_Poisson.h)
  */
 enum class DistributionType {
     VoidDistribution,
@@ -37,7 +46,11 @@ enum class DistributionType {
     BernoulliIntegral,
     PoissonIntegral,
     ExponentialReal,
-    PiecewiseLinearReal
+    PiecewiseLinearReal,
+    ZigguratExponentialReal,
+    ZigguratNormalReal,
+    BernoulliPacked,
+    FastPoissonIntegral
 };
 
 enum class Structure {
@@ -53,8 +66,9 @@ enum class Structure {
 /**
  * Primary template, note it has VoidDistribution as the default DistributionType.
  * @tparam T
+ * @tparam EVENTS container of the events, std::deque by default or Contiguous_Events
  */
-template <class T, DistributionType = DistributionType::VoidDistribution>
+template <class T, DistributionType = DistributionType::VoidDistribution, class EVENTS = std::deque<T>>
 class Distribution {};
 
 //-----------------------------------------------------------------------------
@@ -65,8 +79,8 @@ class Distribution {};
  * Uniform Distribution of Integral values
  * @tparam T should be an integral type (other than bool)
  */
-template <class T>
-class Distribution <T, DistributionType::UniformIntegral> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::UniformIntegral, EVENTS> {
     std::uniform_int_distribution<T> randomDistribution;
     int nr_events;
     Structure structure;
@@ -94,12 +108,14 @@ public:
         std::random_shuffle(events.begin(), events.end());
     }*/
 
-    void load_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void load_random_values(URBG& dre) {
         for ( int ix = 0; ix < nr_events; ++ix )
             events.push_back(randomDistribution(dre));
     }
 
-    void reload_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
         for ( T& value : events )
             value = randomDistribution(dre);
     }
@@ -109,11 +125,13 @@ public:
             events[ix] = vector_of_values[ix];
     }
 
-    void reload_random_value(int index, std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
         events[index] = randomDistribution(dre);
     }
 
-    void add_random_value_to_end(std::default_random_engine& dre) {
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
         events.push_back(randomDistribution(dre));
     }
 
@@ -125,14 +143,14 @@ public:
     }
 
     /**
-    * show_contents - show, on cout, the contents of the deque
+    * show_contents - show, on cout, the contents of the events
     */
     void show_contents() {
         for ( T event : events )
             std::cout << event << "  ";
     }
 
-    std::deque<T> events;
+    EVENTS events;
 };
 
 //-----------------------------------------------------------------------------
@@ -143,8 +161,8 @@ public:
  * Uniform Distribution of Floating Point values
  * @tparam T should be an floating point type
  */
-template <class T>
-class Distribution <T, DistributionType::UniformReal> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::UniformReal, EVENTS> {
     std::uniform_real_distribution<T> randomDistribution;
     int nr_events;
 public:
@@ -162,12 +180,14 @@ public:
           //  events.push_back(randomDistribution(dre));
     }
 
-    void load_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void load_random_values(URBG& dre) {
         for ( int ix = 0; ix < nr_events; ++ix )
             events.push_back(randomDistribution(dre));
     }
 
-    void reload_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
         for ( T& value : events )
             value = randomDistribution(dre);
     }
@@ -177,11 +197,13 @@ public:
             events[ix] = vector_of_values[ix];
     }
 
-    void reload_random_value(int index, std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
         events[index] = randomDistribution(dre);
     }
 
-    void add_random_value_to_end(std::default_random_engine& dre) {
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
         events.push_back(randomDistribution(dre));
     }
 
@@ -193,14 +215,14 @@ public:
     }
 
     /**
-    * show_contents - show, on cout, the contents of the deque
+    * show_contents - show, on cout, the contents of the events
     */
     void show_contents() {
         for ( T event : events )
             std::cout << event << "  ";
     }
 
-    std::deque<T> events;
+    EVENTS events;
 };
 
 //-----------------------------------------------------------------------------
@@ -212,8 +234,8 @@ public:
  * @tparam T should be an integral type, suggest type restricted to 0 (false) and 1 (true)
  *
  */
-template <class T>
-class Distribution <T, DistributionType::BernoulliIntegral> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::BernoulliIntegral, EVENTS> {
     std::bernoulli_distribution randomDistribution;
     int nr_events;
 public:
@@ -243,12 +265,14 @@ public:
           //  events.push_back(randomDistribution(dre));
     }
 
-    void load_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void load_random_values(URBG& dre) {
         for ( int ix = 0; ix < nr_events; ++ix )
             events.push_back(randomDistribution(dre));
     }
 
-    void reload_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
         for ( T& value : events )
             value = randomDistribution(dre);
     }
@@ -258,23 +282,25 @@ public:
             events[ix] = vector_of_values[ix];
     }
 
-    void reload_random_value(int index, std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
         events[index] = randomDistribution(dre);
     }
 
-    void add_random_value_to_end(std::default_random_engine& dre) {
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
         events.push_back(randomDistribution(dre));
     }
 
     /**
-    * show_contents - show, on cout, the contents of the deque
+    * show_contents - show, on cout, the contents of the events
     */
     void show_contents() {
         for ( T event : events )
             std::cout << event << "  ";
     }
 
-    std::deque<T> events;
+    EVENTS events;
 };
 
 //-----------------------------------------------------------------------------
@@ -286,20 +312,22 @@ public:
  * @tparam T should be an integral type
  *
  */
-template <class T>
-class Distribution<T, DistributionType::PoissonIntegral> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::PoissonIntegral, EVENTS> {
     std::poisson_distribution<T> randomDistribution;
     int nr_events;
 public:
     Distribution(double _mean, int _nr_events)
             : randomDistribution(_mean), nr_events(_nr_events) {}
 
-    void load_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void load_random_values(URBG& dre) {
         for ( int ix = 0; ix < nr_events; ++ix )
             events.push_back(randomDistribution(dre));
     }
 
-    void reload_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
         for ( T& value : events )
             value = randomDistribution(dre);
     }
@@ -309,23 +337,25 @@ public:
             events[ix] = vector_of_values[ix];
     }
 
-    void reload_random_value(int index, std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
         events[index] = randomDistribution(dre);
     }
 
-    void add_random_value_to_end(std::default_random_engine& dre) {
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
         events.push_back(randomDistribution(dre));
     }
 
     /**
-     * show_contents - show, on cout, the contents of the deque
+     * show_contents - show, on cout, the contents of the events
      */
     void show_contents() {
         for ( T event : events )
             std::cout << event << "  ";
     }
 
-    std::deque<T> events;
+    EVENTS events;
 };
 
 //-----------------------------------------------------------------------------
@@ -337,20 +367,22 @@ public:
  * @tparam T should be a floating point type
  *
  */
-template <class T>
-class Distribution<T, DistributionType::ExponentialReal> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::ExponentialReal, EVENTS> {
     std::exponential_distribution<T> randomDistribution;
     int nr_events;
 public:
     Distribution(double _lambda, int _nr_events)
             : randomDistribution(_lambda), nr_events(_nr_events) {}
 
-    void load_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void load_random_values(URBG& dre) {
         for ( int ix = 0; ix < nr_events; ++ix )
             events.push_back(randomDistribution(dre));
     }
 
-    void reload_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
         for ( T& value : events )
             value = randomDistribution(dre);
     }
@@ -360,23 +392,25 @@ public:
             events[ix] = vector_of_values[ix];
     }
 
-    void reload_random_value(int index, std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
         events[index] = randomDistribution(dre);
     }
 
-    void add_random_value_to_end(std::default_random_engine& dre) {
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
         events.push_back(randomDistribution(dre));
     }
 
     /**
-     * show_contents - show, on cout, the contents of the deque
+     * show_contents - show, on cout, the contents of the events
      */
     void show_contents() {
         for ( T event : events )
             std::cout << event << "  ";
     }
 
-    std::deque<T> events;
+    EVENTS events;
 };
 
 //-----------------------------------------------------------------------------
@@ -388,8 +422,8 @@ public:
  * @tparam T should be a floating point type
  *
  */
-template <class T>
-class Distribution<T, DistributionType::PiecewiseLinearReal> {
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::PiecewiseLinearReal, EVENTS> {
     std::piecewise_linear_distribution<T> randomDistribution;
     int nr_events;
 public:
@@ -398,12 +432,14 @@ public:
             ITERATOR begin_weights, int _nr_events)
             : randomDistribution(_begin_intervals, _end_intervals, begin_weights), nr_events(_nr_events) {}
 
-    void load_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void load_random_values(URBG& dre) {
         for ( int ix = 0; ix < nr_events; ++ix )
             events.push_back(randomDistribution(dre));
     }
 
-    void reload_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
         for ( T& value : events )
             value = randomDistribution(dre);
     }
@@ -413,23 +449,248 @@ public:
             events[ix] = vector_of_values[ix];
     }
 
-    void reload_random_value(int index, std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
         events[index] = randomDistribution(dre);
     }
 
-    void add_random_value_to_end(std::default_random_engine& dre) {
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
         events.push_back(randomDistribution(dre));
     }
 
     /**
-     * show_contents - show, on cout, the contents of the deque
+     * show_contents - show, on cout, the contents of the events
      */
     void show_contents() {
         for ( T event : events )
             std::cout << event << "  ";
     }
 
-    std::deque<T> events;
+    EVENTS events;
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * Template Specialization
+ * Exponential Distribution drawn with the ziggurat method, same parameters as ExponentialReal
+ * @tparam T should be a floating point type
+ *
+ */
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::ZigguratExponentialReal, EVENTS> {
+    Ziggurat_Exponential_Distribution<T> randomDistribution;
+    int nr_events;
+public:
+    Distribution(double _lambda, int _nr_events)
+            : randomDistribution(_lambda), nr_events(_nr_events) {}
+
+    template <class URBG>
+    void load_random_values(URBG& dre) {
+        for ( int ix = 0; ix < nr_events; ++ix )
+            events.push_back(randomDistribution(dre));
+    }
+
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
+        for ( T& value : events )
+            value = randomDistribution(dre);
+    }
+
+    void reload_values (const std::vector<T>& vector_of_values) {
+        for ( int ix = 0; ix < events.size(); ++ix )
+            events[ix] = vector_of_values[ix];
+    }
+
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
+        events[index] = randomDistribution(dre);
+    }
+
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
+        events.push_back(randomDistribution(dre));
+    }
+
+    /**
+     * show_contents - show, on cout, the contents of the events
+     */
+    void show_contents() {
+        for ( T event : events )
+            std::cout << event << "  ";
+    }
+
+    EVENTS events;
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * Template Specialization
+ * Normal Distribution drawn with the ziggurat method
+ * @tparam T should be a floating point type
+ *
+ */
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::ZigguratNormalReal, EVENTS> {
+    Ziggurat_Normal_Distribution<T> randomDistribution;
+    int nr_events;
+public:
+    Distribution(T _mean, T _stddev, int _nr_events)
+            : randomDistribution(_mean, _stddev), nr_events(_nr_events) {}
+
+    template <class URBG>
+    void load_random_values(URBG& dre) {
+        for ( int ix = 0; ix < nr_events; ++ix )
+            events.push_back(randomDistribution(dre));
+    }
+
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
+        for ( T& value : events )
+            value = randomDistribution(dre);
+    }
+
+    void reload_values (const std::vector<T>& vector_of_values) {
+        for ( int ix = 0; ix < events.size(); ++ix )
+            events[ix] = vector_of_values[ix];
+    }
+
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
+        events[index] = randomDistribution(dre);
+    }
+
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
+        events.push_back(randomDistribution(dre));
+    }
+
+    /**
+     * show_contents - show, on cout, the contents of the events
+     */
+    void show_contents() {
+        for ( T event : events )
+            std::cout << event << "  ";
+    }
+
+    EVENTS events;
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * Template Specialization
+ * Bernoulli Distribution with the events bit-packed, for simulations with many flips per trial.
+ * Conditions read events[ix] or iterate over events (as int 0 or 1) as for BernoulliIntegral,
+ * and can use events.sum(), events.longest_run() and events.count_runs().
+ * @tparam T unused, kept for the signature of the other specializations
+ */
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::BernoulliPacked, EVENTS> {
+public:
+    Bernoulli_Bits events;
+
+    /**
+     *
+     * @param _numerator Numerator of probability of 1 (true), exact if _denominator is a power of two
+     * @param _denominator Denominator of probability of 1 (true)
+     * @param _nr_events Number of sequential events to generated
+     */
+    Distribution(T _numerator, T _denominator, int _nr_events)
+            : events(static_cast<std::uint64_t>(_numerator), static_cast<std::uint64_t>(_denominator),
+                     static_cast<std::size_t>(_nr_events)) {}
+
+    /**
+     *
+     * @param probability_of_true Fixed type double representing probability of 1 (true)
+     * @param _nr_events Number of sequential events to generated
+     */
+    Distribution(double probability_of_true, int _nr_events)
+            : events(probability_of_true, static_cast<std::size_t>(_nr_events)) {}
+
+    template <class URBG>
+    void load_random_values(URBG& dre) {
+        events.reload_random_values(dre);
+    }
+
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
+        events.reload_random_values(dre);
+    }
+
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
+        events.reload_random_value(static_cast<std::size_t>(index), dre);
+    }
+
+    /**
+    * show_contents - show, on cout, the contents of the events
+    */
+    void show_contents() {
+        for ( int event : events )
+            std::cout << event << "  ";
+    }
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * Template Specialization
+ * Poisson Distribution drawn from a guide table (small means) or by PTRS (large means),
+ * same parameters as PoissonIntegral
+ * @tparam T should be an integral type
+ *
+ */
+template <class T, class EVENTS>
+class Distribution<T, DistributionType::FastPoissonIntegral, EVENTS> {
+    Fast_Poisson_Distribution<T> randomDistribution;
+    int nr_events;
+public:
+    Distribution(double _mean, int _nr_events)
+            : randomDistribution(_mean), nr_events(_nr_events) {}
+
+    template <class URBG>
+    void load_random_values(URBG& dre) {
+        for ( int ix = 0; ix < nr_events; ++ix )
+            events.push_back(randomDistribution(dre));
+    }
+
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
+        for ( T& value : events )
+            value = randomDistribution(dre);
+    }
+
+    void reload_values (const std::vector<T>& vector_of_values) {
+        for ( int ix = 0; ix < events.size(); ++ix )
+            events[ix] = vector_of_values[ix];
+    }
+
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
+        events[index] = randomDistribution(dre);
+    }
+
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
+        events.push_back(randomDistribution(dre));
+    }
+
+    /**
+     * show_contents - show, on cout, the contents of the events
+     */
+    void show_contents() {
+        for ( T event : events )
+            std::cout << event << "  ";
+    }
+
+    EVENTS events;
 };
 
 #endif //MONTECARLO_DISTRIBUTION_ALPHA_H
@@ -15,11 +15,60 @@
 #include <random>
 #include <algorithm>
 #include <iostream>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <val/montecarlo/Event_Batch.h>
+#include <val/montecarlo/Inverse_Transform.h>
+#include <val/montecarlo/Checkpoint.h>
+#include <val/montecarlo/Bulk_Uniform.h>
+#include <val/montecarlo/Contiguous_Events.h>
+#include <val/montecarlo/Ziggurat.h>
+#include <val/montecarlo/Alias_Table.h>
+#include <val/montecarlo/Fast_Poisson.h>
 
-template <class X_AXIS, class PARAM, template <class> class RANDOM_DIST >
+/**
+ * Fixed_Events - whether EVENTS is a std::array, i.e., nr_events is a compile-time constant.
+ */
+template <class EVENTS>
+struct Fixed_Events : std::false_type {};
+
+template <class T, std::size_t N>
+struct Fixed_Events<std::array<T, N>> : std::true_type {};
+
+/**
+ * fill_unrolled - events[0] = next(), ..., events[N-1] = next() without a loop, in index order.
+ */
+template <class T, std::size_t N, class NEXT>
+inline void fill_unrolled(std::array<T, N>& events, NEXT&& next) {
+    [&]<std::size_t... IX>(std::index_sequence<IX...>) {
+        ((events[IX] = next()), ...);
+    }(std::make_index_sequence<N>{});
+}
+
+/**
+ * checked_nr_events - _nr_events, which must be N if EVENTS is a std::array<T, N>.
+ */
+template <class EVENTS>
+int checked_nr_events(int _nr_events) {
+    if constexpr ( Fixed_Events<EVENTS>::value )
+        if ( _nr_events != static_cast<int>(std::tuple_size_v<EVENTS>) )
+            throw std::invalid_argument("Distribution: nr_events must equal the size of the std::array events");
+    return _nr_events;
+}
+
+/**
+ * EVENTS is the container of the events, std::deque by default; Contiguous_Events keeps them
+ * in one aligned block (contiguous loops in condition functions, no allocation per reload).
+ * std::array<X_AXIS, N> (see Distribution_Fixed below) fixes nr_events at compile time: no
+ * heap, and the loading loops are unrolled.
+ */
+template <class X_AXIS, class PARAM, template <class> class RANDOM_DIST, class EVENTS = std::deque<X_AXIS> >
 class Distribution {
     RANDOM_DIST<X_AXIS> randomDistribution;
     int nr_events;
+    std::vector<X_AXIS> bulk_values; ///> contiguous scratch for reload_random_values_bulk
 public:
 
     /**
@@ -28,7 +77,7 @@ public:
      * This is where the actual 'EVENTS' (in lower case below) are stored and
      * reloaded by the Monte Carlo engine.
      */
-    std::deque<X_AXIS> events;
+    EVENTS events{};     ///> zeros for std::array until loaded
 
     /**
      * Constructor used for uniform integer and real distributions, also the
@@ -42,7 +91,7 @@ public:
             X_AXIS _max_or_stddev,
             int _nr_events)
 
-            : randomDistribution(_min_or_mean, _max_or_stddev), nr_events(_nr_events) {}
+            : randomDistribution(_min_or_mean, _max_or_stddev), nr_events(checked_nr_events<EVENTS>(_nr_events)) {}
 
     /**
      * Constructor used for Bernoulli, Poisson, Exponential distributions
@@ -53,7 +102,7 @@ public:
             PARAM _likelihood,
             int _nr_events)
 
-            : randomDistribution(_likelihood), nr_events(_nr_events) {}
+            : randomDistribution(_likelihood), nr_events(checked_nr_events<EVENTS>(_nr_events)) {}
 
     using ITERATOR = std::vector<double>::iterator;
     /**
@@ -70,7 +119,7 @@ public:
             int _nr_events)
 
             : randomDistribution(_begin_intervals, _end_intervals, _begin_weights),
-            nr_events(_nr_events) {}
+            nr_events(checked_nr_events<EVENTS>(_nr_events)) {}
 
     /**
      * Constructor for the Piece-wise Constant distribution
@@ -88,24 +137,129 @@ public:
             int _nr_events)
 
             : randomDistribution(_begin_intervals, _end_intervals, _begin_weights, _end_weights),
-              nr_events(_nr_events) {}
+              nr_events(checked_nr_events<EVENTS>(_nr_events)) {}
+    int get_nr_events() const { return nr_events; }
+
     //-------------------------------------------------------------------------
     /**
      *
      * @param dre
      */
-    void load_random_values(std::default_random_engine& dre) {
-        for ( int ix = 0; ix < nr_events; ++ix )
-            events.push_back(randomDistribution(dre));
+    template <class URBG>
+    void load_random_values(URBG& dre) {
+        if constexpr ( Fixed_Events<EVENTS>::value )
+            reload_random_values(dre);
+        else {
+            if constexpr ( requires { events.reserve(std::size_t()); } )
+                events.reserve(events.size() + nr_events);
+            for ( int ix = 0; ix < nr_events; ++ix )
+                events.push_back(randomDistribution(dre));
+        }
     }
 
     /**
      *
      * @param dre
      */
-    void reload_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
+        if constexpr ( Fixed_Events<EVENTS>::value )
+            fill_unrolled(events, [&]() { return randomDistribution(dre); });
+        else
+            for ( X_AXIS& value : events )
+                value = randomDistribution(dre);
+    }
+
+    /**
+     * load_batch - fills the trials [first_trial..nr_trials-1] of the batch, consuming dre in
+     * the same order as that many calls to reload_random_values would.
+     * @param batch trial-major buffer with nr_events values per trial
+     * @param dre
+     * @param first_trial trials before this one are left as they are
+     */
+    template <class URBG>
+    void load_batch(Event_Batch<X_AXIS>& batch, URBG& dre, int first_trial = 0) {
+        X_AXIS* first = batch.data() + static_cast<std::size_t>(first_trial) * nr_events;
+        X_AXIS* last = batch.data() + batch.size();
+        for ( X_AXIS* value = first; value != last; ++value )
+            *value = randomDistribution(dre);
+    }
+
+    /**
+     * reload_random_values_bulk - as reload_random_values, but all events are produced by one
+     * bulk fill of the generator (uniform distributions only, see Bulk_Uniform.h).
+     * @param generator bulk generator used in place of an engine
+     */
+    void reload_random_values_bulk(Bulk_Uniform_Generator& generator) {
+        if constexpr ( requires { events.data(); } ) {   ///> contiguous events, no scratch copy
+            fill_distribution(generator, randomDistribution, events.data(), events.size());
+            return;
+        }
+        bulk_values.resize(events.size());
+        fill_distribution(generator, randomDistribution, bulk_values.data(), bulk_values.size());
+        std::copy(bulk_values.begin(), bulk_values.end(), events.begin());
+    }
+
+    /**
+     * load_batch_bulk - as load_batch, filling the batch directly from the bulk generator.
+     * @param batch trial-major buffer with nr_events values per trial
+     * @param generator bulk generator used in place of an engine
+     * @param first_trial trials before this one are left as they are
+     */
+    void load_batch_bulk(Event_Batch<X_AXIS>& batch, Bulk_Uniform_Generator& generator, int first_trial = 0) {
+        std::size_t first = static_cast<std::size_t>(first_trial) * nr_events;
+        fill_distribution(generator, randomDistribution, batch.data() + first, batch.size() - first);
+    }
+
+    /**
+     * mirror_random_values - replaces each event by its antithetic counterpart (u -> 1-u in
+     * terms of the underlying uniform, e.g., x -> lb+ub-x for uniform distributions). Only
+     * available for distributions with an antithetic_value overload (Inverse_Transform.h).
+     */
+    void mirror_random_values() {
+        for ( X_AXIS& value : events )
+            value = antithetic_value(randomDistribution, value);
+    }
+
+    /**
+     * reload_values_from_uniforms - sets the events by inverse transform of the uniforms, e.g.,
+     * the coordinates of a quasi-random point (one per event).
+     * @param uniforms nr_events values in (0,1)
+     */
+    void reload_values_from_uniforms(std::span<const double> uniforms) {
+        for ( int ix = 0; ix < static_cast<int>(events.size()); ++ix )
+            events[ix] = inverse_cdf(randomDistribution, uniforms[ix]);
+    }
+
+    /**
+     * write_state - writes the distribution's internal state (e.g., the cached value of a
+     * normal distribution) and the events, used by checkpoints.
+     * @param o binary output stream
+     */
+    void write_state(std::ostream& o) const {
+        write_stream_state(o, randomDistribution);
+        std::uint64_t nr_stored = events.size();
+        o.write(reinterpret_cast<const char*>(&nr_stored), sizeof(nr_stored));
+        for ( const X_AXIS& value : events )
+            o.write(reinterpret_cast<const char*>(&value), sizeof(X_AXIS));
+    }
+
+    /**
+     * read_state - reads back what write_state wrote.
+     * @param i binary input stream
+     */
+    void read_state(std::istream& i) {
+        read_stream_state(i, randomDistribution);
+        std::uint64_t nr_stored = 0;
+        i.read(reinterpret_cast<char*>(&nr_stored), sizeof(nr_stored));
+        if constexpr ( Fixed_Events<EVENTS>::value ) {
+            if ( nr_stored != events.size() )
+                throw std::runtime_error("Distribution: the checkpoint holds a different number of events");
+        }
+        else
+            events.resize(nr_stored);
         for ( X_AXIS& value : events )
-            value = randomDistribution(dre);
+            i.read(reinterpret_cast<char*>(&value), sizeof(X_AXIS));
     }
 
     /**
@@ -122,7 +276,8 @@ public:
      * @param index
      * @param dre
      */
-    void reload_random_value(int index, std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
         events[index] = randomDistribution(dre);
     }
 
@@ -130,10 +285,20 @@ public:
      *
      * @param dre
      */
-    void add_random_value_to_end(std::default_random_engine& dre) {
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
         events.push_back(randomDistribution(dre));
     }
 
+    /**
+     * draw - one new value of the distribution, not stored in events (see Lazy_Events.h).
+     * @param dre
+     */
+    template <class URBG>
+    X_AXIS draw(URBG& dre) {
+        return randomDistribution(dre);
+    }
+
     /**
      *
      * @return
@@ -143,7 +308,7 @@ public:
     }
 
     /**
-    * show_contents - show, on cout, the contents of the deque
+    * show_contents - show, on cout, the contents of the events
     */
     void show_contents() {
         for ( X_AXIS event : events )
@@ -151,13 +316,14 @@ public:
     }
 };
 
-template <class X_AXIS, class PARAM, class RANDOM_DIST >
+template <class X_AXIS, class PARAM, class RANDOM_DIST, class EVENTS = std::deque<X_AXIS> >
 class Distribution_NTT {  // NTT -> non-template-template
     RANDOM_DIST randomDistribution;
     int nr_events;
+    std::vector<X_AXIS> bulk_values; ///> contiguous scratch for reload_random_values_bulk
 public:
 
-    std::deque<X_AXIS> events;
+    EVENTS events{};     ///> zeros for std::array until loaded
 
     /**
      * Constructor used for uniform integer and real distributions, also the
@@ -171,7 +337,7 @@ public:
             X_AXIS _max_or_stddev,
             int _nr_events)
 
-            : randomDistribution(_min_or_mean, _max_or_stddev), nr_events(_nr_events) {}
+            : randomDistribution(_min_or_mean, _max_or_stddev), nr_events(checked_nr_events<EVENTS>(_nr_events)) {}
 
     /**
      * Constructor used for Bernoulli, Poisson, Exponential distributions
@@ -182,7 +348,7 @@ public:
             PARAM _likelihood,
             int _nr_events)
 
-            : randomDistribution(_likelihood), nr_events(_nr_events) {}
+            : randomDistribution(_likelihood), nr_events(checked_nr_events<EVENTS>(_nr_events)) {}
 
     using ITERATOR = std::vector<double>::iterator;
     /**
@@ -199,7 +365,7 @@ public:
             int _nr_events)
 
             : randomDistribution(_begin_intervals, _end_intervals, _begin_weights),
-              nr_events(_nr_events) {}
+              nr_events(checked_nr_events<EVENTS>(_nr_events)) {}
 
     /**
      * Constructor for the Piece-wise Constant distribution
@@ -217,24 +383,129 @@ public:
             int _nr_events)
 
             : randomDistribution(_begin_intervals, _end_intervals, _begin_weights, _end_weights),
-              nr_events(_nr_events) {}
+              nr_events(checked_nr_events<EVENTS>(_nr_events)) {}
+    int get_nr_events() const { return nr_events; }
+
     //-------------------------------------------------------------------------
     /**
      *
      * @param dre
      */
-    void load_random_values(std::default_random_engine& dre) {
-        for ( int ix = 0; ix < nr_events; ++ix )
-            events.push_back(randomDistribution(dre));
+    template <class URBG>
+    void load_random_values(URBG& dre) {
+        if constexpr ( Fixed_Events<EVENTS>::value )
+            reload_random_values(dre);
+        else {
+            if constexpr ( requires { events.reserve(std::size_t()); } )
+                events.reserve(events.size() + nr_events);
+            for ( int ix = 0; ix < nr_events; ++ix )
+                events.push_back(randomDistribution(dre));
+        }
     }
 
     /**
      *
      * @param dre
      */
-    void reload_random_values(std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_values(URBG& dre) {
+        if constexpr ( Fixed_Events<EVENTS>::value )
+            fill_unrolled(events, [&]() { return randomDistribution(dre); });
+        else
+            for ( X_AXIS& value : events )
+                value = randomDistribution(dre);
+    }
+
+    /**
+     * load_batch - fills the trials [first_trial..nr_trials-1] of the batch, consuming dre in
+     * the same order as that many calls to reload_random_values would.
+     * @param batch trial-major buffer with nr_events values per trial
+     * @param dre
+     * @param first_trial trials before this one are left as they are
+     */
+    template <class URBG>
+    void load_batch(Event_Batch<X_AXIS>& batch, URBG& dre, int first_trial = 0) {
+        X_AXIS* first = batch.data() + static_cast<std::size_t>(first_trial) * nr_events;
+        X_AXIS* last = batch.data() + batch.size();
+        for ( X_AXIS* value = first; value != last; ++value )
+            *value = randomDistribution(dre);
+    }
+
+    /**
+     * reload_random_values_bulk - as reload_random_values, but all events are produced by one
+     * bulk fill of the generator (uniform distributions only, see Bulk_Uniform.h).
+     * @param generator bulk generator used in place of an engine
+     */
+    void reload_random_values_bulk(Bulk_Uniform_Generator& generator) {
+        if constexpr ( requires { events.data(); } ) {   ///> contiguous events, no scratch copy
+            fill_distribution(generator, randomDistribution, events.data(), events.size());
+            return;
+        }
+        bulk_values.resize(events.size());
+        fill_distribution(generator, randomDistribution, bulk_values.data(), bulk_values.size());
+        std::copy(bulk_values.begin(), bulk_values.end(), events.begin());
+    }
+
+    /**
+     * load_batch_bulk - as load_batch, filling the batch directly from the bulk generator.
+     * @param batch trial-major buffer with nr_events values per trial
+     * @param generator bulk generator used in place of an engine
+     * @param first_trial trials before this one are left as they are
+     */
+    void load_batch_bulk(Event_Batch<X_AXIS>& batch, Bulk_Uniform_Generator& generator, int first_trial = 0) {
+        std::size_t first = static_cast<std::size_t>(first_trial) * nr_events;
+        fill_distribution(generator, randomDistribution, batch.data() + first, batch.size() - first);
+    }
+
+    /**
+     * mirror_random_values - replaces each event by its antithetic counterpart (u -> 1-u in
+     * terms of the underlying uniform, e.g., x -> lb+ub-x for uniform distributions). Only
+     * available for distributions with an antithetic_value overload (Inverse_Transform.h).
+     */
+    void mirror_random_values() {
+        for ( X_AXIS& value : events )
+            value = antithetic_value(randomDistribution, value);
+    }
+
+    /**
+     * reload_values_from_uniforms - sets the events by inverse transform of the uniforms, e.g.,
+     * the coordinates of a quasi-random point (one per event).
+     * @param uniforms nr_events values in (0,1)
+     */
+    void reload_values_from_uniforms(std::span<const double> uniforms) {
+        for ( int ix = 0; ix < static_cast<int>(events.size()); ++ix )
+            events[ix] = inverse_cdf(randomDistribution, uniforms[ix]);
+    }
+
+    /**
+     * write_state - writes the distribution's internal state (e.g., the cached value of a
+     * normal distribution) and the events, used by checkpoints.
+     * @param o binary output stream
+     */
+    void write_state(std::ostream& o) const {
+        write_stream_state(o, randomDistribution);
+        std::uint64_t nr_stored = events.size();
+        o.write(reinterpret_cast<const char*>(&nr_stored), sizeof(nr_stored));
+        for ( const X_AXIS& value : events )
+            o.write(reinterpret_cast<const char*>(&value), sizeof(X_AXIS));
+    }
+
+    /**
+     * read_state - reads back what write_state wrote.
+     * @param i binary input stream
+     */
+    void read_state(std::istream& i) {
+        read_stream_state(i, randomDistribution);
+        std::uint64_t nr_stored = 0;
+        i.read(reinterpret_cast<char*>(&nr_stored), sizeof(nr_stored));
+        if constexpr ( Fixed_Events<EVENTS>::value ) {
+            if ( nr_stored != events.size() )
+                throw std::runtime_error("Distribution: the checkpoint holds a different number of events");
+        }
+        else
+            events.resize(nr_stored);
         for ( X_AXIS& value : events )
-            value = randomDistribution(dre);
+            i.read(reinterpret_cast<char*>(&value), sizeof(X_AXIS));
     }
 
     /**
@@ -251,7 +522,8 @@ public:
      * @param index
      * @param dre
      */
-    void reload_random_value(int index, std::default_random_engine& dre) {
+    template <class URBG>
+    void reload_random_value(int index, URBG& dre) {
         events[index] = randomDistribution(dre);
     }
 
@@ -259,10 +531,20 @@ public:
      *
      * @param dre
      */
-    void add_random_value_to_end(std::default_random_engine& dre) {
+    template <class URBG>
+    void add_random_value_to_end(URBG& dre) {
         events.push_back(randomDistribution(dre));
     }
 
+    /**
+     * draw - one new value of the distribution, not stored in events (see Lazy_Events.h).
+     * @param dre
+     */
+    template <class URBG>
+    X_AXIS draw(URBG& dre) {
+        return randomDistribution(dre);
+    }
+
     /**
      *
      * @return
@@ -272,7 +554,7 @@ public:
     }
 
     /**
-    * show_contents - show, on cout, the contents of the deque
+    * show_contents - show, on cout, the contents of the events
     */
     void show_contents() {
         for ( X_AXIS event : events )
@@ -280,4 +562,21 @@ public:
     }
 };
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * Distribution_Fixed, Distribution_NTT_Fixed - nr_events known at compile time, e.g.,
+ * Distribution_Fixed<int, int, std::uniform_int_distribution, 2> two_dice(1, 6, 2);
+ * The events are a std::array member (conditions can take N from std::tuple_size), reloads are
+ * unrolled and nothing is allocated, so a small trial can stay in registers once the
+ * simulation's trial loop is inlined (make_monte_carlo_simulation with a lambda condition).
+ * The constructors still take nr_events, which must be N.
+ */
+template <class X_AXIS, class PARAM, template <class> class RANDOM_DIST, std::size_t N>
+using Distribution_Fixed = Distribution<X_AXIS, PARAM, RANDOM_DIST, std::array<X_AXIS, N>>;
+
+template <class X_AXIS, class PARAM, class RANDOM_DIST, std::size_t N>
+using Distribution_NTT_Fixed = Distribution_NTT<X_AXIS, PARAM, RANDOM_DIST, std::array<X_AXIS, N>>;
+
 #endif //MONTECARLO_DISTRIBUTION_BETA_H
@@ -0,0 +1,80 @@
+/**
+ * \file Event_Batch.h
+ * \date 17-Oct-2026
+ *
+ * \brief Contiguous, cache-line aligned buffer holding the events of a batch of trials.
+ *
+ * \details The layout is trial-major: the nr_events values of trial k occupy
+ * [k*nr_events, (k+1)*nr_events) so that each trial can be handed to a condition
+ * function as a std::span. The buffer is filled by Distribution::load_batch in one
+ * tight loop instead of one reload_random_values call per trial.
+ * Use case is MonteCarloSimulation::run_batched.
+ */
+
+#ifndef MONTECARLO_EVENT_BATCH_H
+#define MONTECARLO_EVENT_BATCH_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+
+constexpr std::size_t cache_line_size = 64; ///> alignment used for contiguous event storage
+
+template <class X_AXIS>
+class Event_Batch {
+
+    struct Aligned_Delete {
+        void operator()(X_AXIS* p) const {
+            ::operator delete[](p, std::align_val_t(cache_line_size));
+        }
+    };
+
+    int nr_events;          ///> events per trial
+    int capacity_trials;    ///> number of trials the buffer was allocated for
+    int nr_trials;          ///> number of trials currently held (<= capacity_trials)
+    std::unique_ptr<X_AXIS[], Aligned_Delete> values; ///> capacity_trials * nr_events values
+
+public:
+
+    /**
+     * Event_Batch constructor - allocates (but does not fill) storage for _capacity_trials trials.
+     * @param _capacity_trials number of trials held by a full batch
+     * @param _nr_events number of events of each trial
+     */
+    Event_Batch(int _capacity_trials, int _nr_events)
+            : nr_events(_nr_events), capacity_trials(_capacity_trials), nr_trials(_capacity_trials),
+              values(static_cast<X_AXIS*>(::operator new[](
+                      sizeof(X_AXIS) * static_cast<std::size_t>(_capacity_trials) * _nr_events,
+                      std::align_val_t(cache_line_size)))) {}
+
+    /**
+     * set_nr_trials - shrinks (or restores) the number of trials in use, e.g., for the last
+     * partial batch of a run.
+     * @param _nr_trials number of trials, must not exceed the capacity
+     */
+    void set_nr_trials(int _nr_trials) { nr_trials = _nr_trials; }
+
+    int get_nr_trials() const { return nr_trials; }
+    int get_nr_events() const { return nr_events; }
+    int get_capacity() const { return capacity_trials; }
+
+    X_AXIS* data() { return values.get(); }
+    const X_AXIS* data() const { return values.get(); }
+    std::size_t size() const { return static_cast<std::size_t>(nr_trials) * nr_events; }
+
+    /**
+     * trial - view of the events of one trial.
+     * @param index trial within the batch [0..nr_trials-1]
+     * @return span of nr_events values
+     */
+    std::span<X_AXIS> trial(int index) {
+        return std::span<X_AXIS>(values.get() + static_cast<std::size_t>(index) * nr_events, nr_events);
+    }
+
+    std::span<const X_AXIS> trial(int index) const {
+        return std::span<const X_AXIS>(values.get() + static_cast<std::size_t>(index) * nr_events, nr_events);
+    }
+};
+
+#endif //MONTECARLO_EVENT_BATCH_H
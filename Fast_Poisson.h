@@ -0,0 +1,167 @@
+/**
+ * \file Fast_Poisson.h
+ * \date 17-Oct-2026
+ *
+ * \brief Fast_Poisson_Distribution, a drop-in replacement of std::poisson_distribution that
+ * precomputes its tables once: a guide table (inverse transform) for small means and the
+ * constants of PTRS transformed rejection (Hormann, 1993) for large ones.
+ *
+ * \details Below table_mean_limit (256) the CDF is tabulated up to where it rounds to 1 (the tail
+ * beyond holds less than 2^-53 of the mass, below the resolution of the uniform), and a guide
+ * table of the same size gives the first candidate value for a uniform u, so a draw is one
+ * random word and one or two comparisons on average (the table has a few hundred entries at
+ * most; it could not start from e^-mean above 745 anyway). From the limit on, PTRS takes
+ * two uniforms and accepts about 90% of the pairs with a few multiplications; the rest needs
+ * a log and lgamma. std::poisson_distribution instead uses a multiplication per unit of the
+ * mean below 12 and a rejection with several logs above.
+ * The interface is that of the standard distribution (constructor from the mean,
+ * operator()(URBG&), mean, min, max, reset, stream operators), so it can be given as
+ * RANDOM_DIST of Distribution_NTT or STD_DIST of Distribution (PARAM being the real mean),
+ * checkpointed runs included; the values
+ * differ from those of std::poisson_distribution for the same engine (the distribution is
+ * the same). A bulk fill from Bulk_Uniform_Generator is provided as for the other samplers.
+ */
+
+#ifndef MONTECARLO_FAST_POISSON_H
+#define MONTECARLO_FAST_POISSON_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+#include <val/montecarlo/Random_Engines.h>
+#include <val/montecarlo/Bulk_Uniform.h>
+
+template <class IntType = int>
+class Fast_Poisson_Distribution {
+public:
+    using result_type = IntType;
+    static constexpr double table_mean_limit = 256.0;    ///> guide table below, PTRS from here on
+
+private:
+    double mean_value;
+    std::vector<double> cdf;            ///> P(X <= k), the last entry set to 1
+    std::vector<std::uint32_t> guide;   ///> guide[g] = smallest k with cdf[k] > g / guide.size()
+    double a, b, inverse_alpha, v_r, log_mean;  ///> PTRS constants
+
+    static double uniform(std::uint64_t word) { return static_cast<double>(word >> 11) * 0x1.0p-53; }
+
+    void build_table() {
+        double pmf = std::exp(-mean_value);
+        double sum = pmf;
+        cdf.push_back(sum);
+        for ( int k = 1; sum < 1.0 && pmf > 0.0; ++k ) {
+            pmf *= mean_value / k;
+            sum += pmf;
+            cdf.push_back(sum);
+        }
+        cdf.back() = 1.0;
+        guide.resize(cdf.size());
+        std::size_t k = 0;
+        for ( std::size_t g = 0; g < guide.size(); ++g ) {
+            double level = static_cast<double>(g) / static_cast<double>(guide.size());
+            while ( cdf[k] <= level )
+                ++k;
+            guide[g] = static_cast<std::uint32_t>(k);
+        }
+    }
+
+    template <class URBG>
+    result_type draw_table(URBG& dre) const {
+        double u = uniform(random_word(dre));
+        std::size_t k = guide[static_cast<std::size_t>(u * static_cast<double>(guide.size()))];
+        while ( cdf[k] <= u )
+            ++k;
+        return static_cast<result_type>(k);
+    }
+
+    template <class URBG>
+    result_type draw_ptrs(URBG& dre) const {
+        for ( ;; ) {
+            double u = uniform(random_word(dre)) - 0.5;
+            double v = uniform(random_word(dre));
+            double us = 0.5 - std::abs(u);
+            double k = std::floor((2.0 * a / us + b) * u + mean_value + 0.43);
+            if ( us >= 0.07 && v <= v_r )
+                return static_cast<result_type>(k);
+            if ( k < 0.0 || (us < 0.013 && v > us) )
+                continue;
+            if ( std::log(v) + std::log(inverse_alpha) - std::log(a / (us * us) + b)
+                 <= -mean_value + k * log_mean - std::lgamma(k + 1.0) )
+                return static_cast<result_type>(k);
+        }
+    }
+
+public:
+
+    /**
+     * Fast_Poisson_Distribution constructor - builds the table or the PTRS constants.
+     * @param _mean mean, non-negative
+     */
+    explicit Fast_Poisson_Distribution(double _mean = 1.0)
+            : mean_value(_mean), a(0.0), b(0.0), inverse_alpha(0.0), v_r(0.0), log_mean(0.0) {
+        if ( !(_mean >= 0.0) )
+            throw std::invalid_argument("Fast_Poisson_Distribution: mean must be non-negative");
+        if ( mean_value < table_mean_limit )
+            build_table();
+        else {
+            double root = std::sqrt(mean_value);
+            log_mean = std::log(mean_value);
+            b = 0.931 + 2.53 * root;
+            a = -0.059 + 0.02483 * b;
+            inverse_alpha = 1.1239 + 1.1328 / (b - 3.4);
+            v_r = 0.9277 - 3.6224 / (b - 2.0);
+        }
+    }
+
+    template <class URBG>
+    result_type operator()(URBG& dre) const {
+        return mean_value < table_mean_limit ? draw_table(dre) : draw_ptrs(dre);
+    }
+
+    double mean() const { return mean_value; }
+    result_type min() const { return 0; }
+    result_type max() const { return std::numeric_limits<result_type>::max(); }
+    void reset() {}
+
+    friend bool operator==(const Fast_Poisson_Distribution& x, const Fast_Poisson_Distribution& y) {
+        return x.mean_value == y.mean_value;
+    }
+
+    /**
+     * stream operators - the mean, as for std::poisson_distribution; the tables are rebuilt from
+     * it on reading (deterministically, so a resumed run draws the same values).
+     */
+    friend std::ostream& operator<<(std::ostream& o, const Fast_Poisson_Distribution& d) {
+        std::ios_base::fmtflags flags = o.flags(std::ios_base::scientific);
+        std::streamsize precision = o.precision(std::numeric_limits<double>::max_digits10);
+        o << d.mean_value;
+        o.flags(flags);
+        o.precision(precision);
+        return o;
+    }
+
+    friend std::istream& operator>>(std::istream& i, Fast_Poisson_Distribution& d) {
+        double _mean;
+        if ( i >> _mean )
+            d = Fast_Poisson_Distribution(_mean);
+        return i;
+    }
+};
+
+/**
+ * fill_distribution - bulk fill for Fast_Poisson_Distribution (see Bulk_Uniform.h).
+ */
+template <class T>
+void fill_distribution(Bulk_Uniform_Generator& generator, const Fast_Poisson_Distribution<T>& distribution,
+        T* out, std::size_t n) {
+    Bulk_Word_Stream words(generator);
+    for ( std::size_t ix = 0; ix < n; ++ix )
+        out[ix] = distribution(words);
+}
+
+#endif //MONTECARLO_FAST_POISSON_H
@@ -13,6 +13,7 @@
  *      - increment_bin: increments bin by 1 for counting applications
  *      - add_to_bin: increments bin by an input parameter amount
  *      - get_midpoint: returns bin number by which 50% probability has been reached
+ *      - operator+=: adds the amounts of a histogram with the same intervals (merge)
  */
 
 #ifndef MONTECARLO_HISTOGRAM_H
@@ -20,6 +21,9 @@
 
 #include <vector>
 #include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <cstddef>
 
 template <typename T, typename U>
 class Bin;
@@ -48,10 +52,10 @@ public:
      * @param _size - bin_width
      */
     Bin(int _index, X_AXIS _right_edge_interval, X_AXIS _size) :
-            index(_index),
             right_edge_interval(_right_edge_interval),
             size_interval(_size),
-            amount(0) {}
+            amount(0),
+            index(_index) {}
 
     /**
      * inc_count_if_less_equal - tests an input parameter value for being less than or
@@ -241,6 +245,139 @@ public:
     int size() {return nr_bins;}
     U get_amount(int ix) {return bins[ix].amount;}
 
+    /**
+     * write_binary - writes the amounts (bins, total, too high, too low) for a checkpoint;
+     * the interval structure is given by the constructor and is not written.
+     * @param o binary output stream
+     */
+    void write_binary(std::ostream& o) const {
+        o.write(reinterpret_cast<const char*>(&nr_bins), sizeof(nr_bins));
+        for ( const Bin<T,U>& b : bins )
+            o.write(reinterpret_cast<const char*>(&b.amount), sizeof(U));
+        o.write(reinterpret_cast<const char*>(&total_amount), sizeof(U));
+        o.write(reinterpret_cast<const char*>(&bin_too_hi), sizeof(U));
+        o.write(reinterpret_cast<const char*>(&bin_too_lo), sizeof(U));
+    }
+
+    /**
+     * read_binary - reads back the amounts written by write_binary into a histogram constructed
+     * with the same intervals.
+     * @param i binary input stream
+     */
+    void read_binary(std::istream& i) {
+        int stored_nr_bins = 0;
+        i.read(reinterpret_cast<char*>(&stored_nr_bins), sizeof(stored_nr_bins));
+        if ( stored_nr_bins != nr_bins )
+            throw std::runtime_error("Histogram: stored number of bins does not match");
+        for ( Bin<T,U>& b : bins )
+            i.read(reinterpret_cast<char*>(&b.amount), sizeof(U));
+        i.read(reinterpret_cast<char*>(&total_amount), sizeof(U));
+        i.read(reinterpret_cast<char*>(&bin_too_hi), sizeof(U));
+        i.read(reinterpret_cast<char*>(&bin_too_lo), sizeof(U));
+    }
+
+    /**
+     * raw_size - number of amounts exported by export_amounts (bins, total, too high, too low).
+     */
+    std::size_t raw_size() const { return bins.size() + 3; }
+
+    /**
+     * export_amounts - copies the amounts to raw_size() consecutive values, e.g., into shared
+     * memory; the interval structure is not exported.
+     */
+    void export_amounts(U* out) const {
+        for ( const Bin<T,U>& b : bins )
+            *out++ = b.amount;
+        *out++ = total_amount;
+        *out++ = bin_too_hi;
+        *out = bin_too_lo;
+    }
+
+    /**
+     * add_amounts - adds amounts exported by a histogram with the same intervals to this one.
+     */
+    void add_amounts(const U* in) {
+        for ( Bin<T,U>& b : bins )
+            b.amount += *in++;
+        total_amount += *in++;
+        bin_too_hi += *in++;
+        bin_too_lo += *in;
+    }
+
+    /**
+     * clear_amounts - sets all amounts to zero, keeping the intervals.
+     */
+    void clear_amounts() {
+        for ( Bin<T,U>& b : bins )
+            b.amount = 0;
+        total_amount = 0;
+        bin_too_hi = 0;
+        bin_too_lo = 0;
+    }
+
+    /**
+     * same_intervals - whether other has the same lower bound, upper bound and bin width, i.e.,
+     * whether their amounts can be added up bin by bin.
+     */
+    bool same_intervals(const Histogram<T,U>& other) const {
+        return lower_bound_left_edge == other.lower_bound_left_edge
+               && upper_bound_right_edge == other.upper_bound_right_edge
+               && bin_width == other.bin_width;
+    }
+
+    /**
+     * bin_index - index in the bins of the bin that increment_bin and add_to_bin use.
+     * @param which_bin - external indication of the bin, as for increment_bin
+     * @return index in [0, nr_bins), std::out_of_range is thrown otherwise
+     */
+    int bin_index(int which_bin) const {
+        int adjusted_index = which_bin - (lower_bound_left_edge + bin_width);
+        adjusted_index /= bin_width;
+        if ( adjusted_index < 0 || adjusted_index >= nr_bins )
+            throw std::out_of_range("Histogram: bin out of range");
+        return adjusted_index;
+    }
+
+    /**
+     * range_index - index in the exported amounts (see export_amounts) that
+     * increment_if_in_range and add_if_in_range add to for x_axis_value: a bin, too_hi_index()
+     * or too_lo_index(); raw_size() for a value in range that is past the last bin, which is
+     * not counted.
+     */
+    std::size_t range_index(T x_axis_value) const {
+        if (x_axis_value < lower_bound_left_edge)
+            return too_lo_index();
+        if (x_axis_value > upper_bound_right_edge)
+            return too_hi_index();
+        int index_bin = static_cast<int>(std::floor((x_axis_value - lower_bound_left_edge) * bin_width_inverse));
+        return index_bin < nr_bins ? static_cast<std::size_t>(index_bin) : raw_size();
+    }
+
+    std::size_t total_index() const { return bins.size(); }
+    std::size_t too_hi_index() const { return bins.size() + 1; }
+    std::size_t too_lo_index() const { return bins.size() + 2; }
+
+    /**
+     * operator+= - adds the amounts of other (bins, total, too high, too low) to this histogram,
+     * e.g., to merge histograms filled by different workers.
+     * @param other histogram with the same intervals, std::invalid_argument is thrown otherwise
+     */
+    Histogram<T,U>& operator+=(const Histogram<T,U>& other) {
+        if ( !same_intervals(other) )
+            throw std::invalid_argument("Histogram: cannot add histograms with different intervals");
+        for ( std::size_t ix = 0; ix < bins.size(); ++ix )
+            bins[ix].amount += other.bins[ix].amount;
+        total_amount += other.total_amount;
+        bin_too_hi += other.bin_too_hi;
+        bin_too_lo += other.bin_too_lo;
+        return *this;
+    }
+
+    friend Histogram<T,U> operator+(Histogram<T,U> a, const Histogram<T,U>& b) {
+        a += b;
+        return a;
+    }
+
     /**
      * output stream operator, standard output of histogram. Currently, outputs in format
      * for Python (also many others I am reasonably sure) to read for graphing.
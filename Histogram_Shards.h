@@ -0,0 +1,157 @@
+/**
+ * \file Histogram_Shards.h
+ * \date 17-Oct-2026
+ *
+ * \brief Histogram_Shards, per-worker amounts of a Histogram so that the workers of
+ * run_parallel can fill it without locks, merged into the Histogram once they are joined.
+ *
+ * \details Each shard is a row of raw_size() amounts laid out as in Histogram::export_amounts
+ * (bins, total, too high, too low); the rows start on their own cache lines and are padded to
+ * a whole number of them, so no two workers ever write to the same line. A shard uses the
+ * binning of the target histogram (bin_index, range_index), and merge() adds the rows to it
+ * in shard order, so integral amounts end up exactly as if one thread had filled the
+ * histogram with the same values (for floating point amounts the order of the additions
+ * differs). The shard of the calling thread is local(): run_worker binds worker k to shard k
+ * through histogram_shard_index, and any other thread uses shard 0 unless it opens a
+ * Histogram_Shard_Scope itself. A condition_met that captures the shards by reference and
+ * fills shards.local() is therefore safe in run_parallel, e.g.,
+ *      Histogram_Shards<int, int> shards(histogram, nr_threads);
+ *      ... [&shards](auto& d, int& v, auto&) { shards.local().increment_if_in_range(d.events[0]); ... }
+ *      simulation.run_parallel(nr_threads, shards);
+ */
+
+#ifndef MONTECARLO_HISTOGRAM_SHARDS_H
+#define MONTECARLO_HISTOGRAM_SHARDS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <val/montecarlo/Histogram.h>
+#include <val/montecarlo/Event_Batch.h>
+
+inline thread_local int histogram_shard_index = 0;  ///> shard of the calling thread, see Histogram_Shards::local
+
+/**
+ * Histogram_Shard_Scope - binds the calling thread to a shard for its lifetime.
+ */
+class Histogram_Shard_Scope {
+    int previous;
+public:
+    explicit Histogram_Shard_Scope(int shard) : previous(histogram_shard_index) { histogram_shard_index = shard; }
+    ~Histogram_Shard_Scope() { histogram_shard_index = previous; }
+    Histogram_Shard_Scope(const Histogram_Shard_Scope&) = delete;
+    Histogram_Shard_Scope& operator=(const Histogram_Shard_Scope&) = delete;
+};
+
+/**
+ * Histogram_Shard - one worker's row of amounts, filled with the same calls as Histogram.
+ */
+template <class T, class U>
+class Histogram_Shard {
+    const Histogram<T,U>* layout;   ///> intervals of the target histogram
+    U* amounts;                     ///> raw_size() amounts, as in Histogram::export_amounts
+
+public:
+    Histogram_Shard(const Histogram<T,U>* _layout, U* _amounts) : layout(_layout), amounts(_amounts) {}
+
+    void increment_bin(int which_bin) {
+        amounts[layout->bin_index(which_bin)] += 1;
+        amounts[layout->total_index()] += 1;
+    }
+
+    void add_to_bin(int which_bin, U _amount) {
+        amounts[layout->bin_index(which_bin)] += _amount;
+        amounts[layout->total_index()] += _amount;
+    }
+
+    void increment_if_in_range(T x_axis_value) {
+        std::size_t ix = layout->range_index(x_axis_value);
+        if ( ix < layout->raw_size() )
+            amounts[ix] += 1;
+    }
+
+    void add_if_in_range(T x_axis_value, U _amount) {
+        std::size_t ix = layout->range_index(x_axis_value);
+        if ( ix < layout->raw_size() )
+            amounts[ix] += _amount;
+    }
+
+    U get_amount(int ix) const { return amounts[ix]; }
+};
+
+template <class T, class U>
+class Histogram_Shards {
+    static_assert(std::is_trivially_copyable_v<U>, "histogram amounts must be trivially copyable");
+
+    struct Aligned_Delete {
+        void operator()(U* p) const {
+            ::operator delete[](p, std::align_val_t(cache_line_size));
+        }
+    };
+
+    Histogram<T,U>& target;     ///> histogram the shards are merged into
+    int nr_shards;
+    std::size_t row_size;       ///> amounts per shard, raw_size() rounded up to whole cache lines
+    std::unique_ptr<U[], Aligned_Delete> rows;  ///> nr_shards * row_size amounts
+
+    static std::size_t padded(std::size_t nr_amounts) {
+        std::size_t per_line = std::max<std::size_t>(1, cache_line_size / sizeof(U));
+        return (nr_amounts + per_line - 1) / per_line * per_line;
+    }
+
+public:
+
+    /**
+     * Histogram_Shards constructor - all shards empty.
+     * @param _target histogram giving the intervals and receiving the merged amounts, must
+     * outlive the shards
+     * @param _nr_shards number of shards, at least the number of workers filling them
+     */
+    Histogram_Shards(Histogram<T,U>& _target, int _nr_shards)
+            : target(_target), nr_shards(_nr_shards), row_size(padded(_target.raw_size())) {
+        if ( nr_shards < 1 )
+            throw std::invalid_argument("Histogram_Shards: at least one shard is needed");
+        std::size_t nr_amounts = row_size * static_cast<std::size_t>(nr_shards);
+        rows.reset(static_cast<U*>(::operator new[](sizeof(U) * nr_amounts, std::align_val_t(cache_line_size))));
+        std::fill(rows.get(), rows.get() + nr_amounts, U(0));
+    }
+
+    int get_nr_shards() const { return nr_shards; }
+
+    /**
+     * shard - the shard of a worker.
+     * @param index [0..nr_shards-1], std::out_of_range is thrown otherwise
+     */
+    Histogram_Shard<T,U> shard(int index) {
+        if ( index < 0 || index >= nr_shards )
+            throw std::out_of_range("Histogram_Shards: no shard for this worker");
+        return Histogram_Shard<T,U>(&target, rows.get() + row_size * static_cast<std::size_t>(index));
+    }
+
+    /**
+     * local - the shard of the calling thread (histogram_shard_index).
+     */
+    Histogram_Shard<T,U> local() { return shard(histogram_shard_index); }
+
+    /**
+     * clear - sets the amounts of all shards to zero.
+     */
+    void clear() {
+        std::fill(rows.get(), rows.get() + row_size * static_cast<std::size_t>(nr_shards), U(0));
+    }
+
+    /**
+     * merge - adds the shards to the target histogram in shard order and clears them. Must not
+     * run while workers are filling the shards.
+     */
+    void merge() {
+        for ( int sx = 0; sx < nr_shards; ++sx )
+            target.add_amounts(rows.get() + row_size * static_cast<std::size_t>(sx));
+        clear();
+    }
+};
+
+#endif //MONTECARLO_HISTOGRAM_SHARDS_H
@@ -0,0 +1,211 @@
+/**
+ * \file Instrumentation.h
+ * \date 17-Oct-2026
+ *
+ * \brief Per-phase instrumentation of the trial loops of MonteCarloSimulation, StateMatrix and
+ * List_Without_Repetition: cycles spent drawing random values, in the condition and in the
+ * accumulation, random draws per trial and trials per second.
+ *
+ * \details Compiled in only when MONTECARLO_INSTRUMENT is defined before the engines are
+ * included; otherwise the trial loops are the plain ones and Instrumentation_Stats stays at
+ * zero. Phases are timed with the time stamp counter on x86 (steady_clock nanoseconds
+ * elsewhere), which costs some 20-30 cycles per reading, so the instrumented run is a little
+ * slower than the plain one and very cheap phases are overestimated. Random draws are counted
+ * by passing a Counting_Engine in place of the engine where the engine accepts any URBG (the
+ * distributions, State::get_next_state, std::shuffle); draws that a condition function makes
+ * itself are included in its time but not in the count.
+ * With MONTECARLO_INSTRUMENT_PERF also defined (Linux only) the run reads the hardware cycle,
+ * instruction, cache miss and branch miss counters through perf_event_open; if the kernel
+ * refuses (perf_event_paranoid, containers) the run proceeds and hardware_valid stays false.
+ */
+
+#ifndef MONTECARLO_INSTRUMENTATION_H
+#define MONTECARLO_INSTRUMENTATION_H
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(MONTECARLO_INSTRUMENT_PERF) && defined(__linux__)
+#include <array>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * cycle_counter - time stamp counter on x86, steady_clock nanoseconds elsewhere.
+ */
+inline std::uint64_t cycle_counter() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * Instrumentation_Stats - what an instrumented run measured, reset at the start of each run.
+ */
+struct Instrumentation_Stats {
+    std::uint64_t nr_trials = 0;
+    std::uint64_t rng_cycles = 0;        ///> drawing random values (reload, transitions, shuffles)
+    std::uint64_t condition_cycles = 0;  ///> condition function
+    std::uint64_t accumulate_cycles = 0; ///> adding up interim values
+    std::uint64_t rng_draws = 0;         ///> calls of the engine
+    double seconds = 0.0;                ///> wall time of the run
+
+    bool hardware_valid = false;         ///> whether the counters below were read
+    std::uint64_t hardware_cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t cache_misses = 0;
+    std::uint64_t branch_misses = 0;
+
+    double trials_per_second() const { return seconds > 0.0 ? static_cast<double>(nr_trials) / seconds : 0.0; }
+
+    double draws_per_trial() const {
+        return nr_trials > 0 ? static_cast<double>(rng_draws) / static_cast<double>(nr_trials) : 0.0;
+    }
+
+    double cycles_per_trial(std::uint64_t cycles) const {
+        return nr_trials > 0 ? static_cast<double>(cycles) / static_cast<double>(nr_trials) : 0.0;
+    }
+
+    void print(std::ostream& o = std::cout) const {
+        o << "trials = " << nr_trials << ", trials/second = " << trials_per_second()
+          << ", draws/trial = " << draws_per_trial() << '\n'
+          << "cycles/trial: rng = " << cycles_per_trial(rng_cycles)
+          << ", condition = " << cycles_per_trial(condition_cycles)
+          << ", accumulate = " << cycles_per_trial(accumulate_cycles) << '\n';
+        if ( hardware_valid )
+            o << "hardware: cycles = " << hardware_cycles << ", instructions = " << instructions
+              << ", cache misses = " << cache_misses << ", branch misses = " << branch_misses << '\n';
+    }
+};
+
+/**
+ * Counting_Engine - forwards to an engine and counts the values drawn from it, so the stream
+ * is the same as drawing from the engine directly.
+ * @tparam URBG - the engine wrapped
+ */
+template <class URBG>
+class Counting_Engine {
+    URBG& engine;
+    std::uint64_t nr_draws;
+public:
+    using result_type = typename URBG::result_type;
+
+    static constexpr result_type min() { return URBG::min(); }
+    static constexpr result_type max() { return URBG::max(); }
+
+    explicit Counting_Engine(URBG& _engine) : engine(_engine), nr_draws(0) {}
+
+    result_type operator()() {
+        ++nr_draws;
+        return engine();
+    }
+
+    std::uint64_t get_nr_draws() const { return nr_draws; }
+};
+
+/**
+ * Hardware_Counters - cycles, instructions, cache misses and branch misses of the calling
+ * thread through perf_event_open; an empty shell unless MONTECARLO_INSTRUMENT_PERF is defined
+ * on Linux.
+ */
+class Hardware_Counters {
+#if defined(MONTECARLO_INSTRUMENT_PERF) && defined(__linux__)
+    std::array<int, 4> descriptors;
+
+    static int open_counter(std::uint64_t config, int group) {
+        perf_event_attr attributes;
+        std::memset(&attributes, 0, sizeof(attributes));
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.disabled = group == -1 ? 1 : 0;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, group, 0));
+    }
+
+public:
+    Hardware_Counters() {
+        descriptors[0] = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+        descriptors[1] = open_counter(PERF_COUNT_HW_INSTRUCTIONS, descriptors[0]);
+        descriptors[2] = open_counter(PERF_COUNT_HW_CACHE_MISSES, descriptors[0]);
+        descriptors[3] = open_counter(PERF_COUNT_HW_BRANCH_MISSES, descriptors[0]);
+    }
+
+    ~Hardware_Counters() {
+        for ( int descriptor : descriptors )
+            if ( descriptor >= 0 ) close(descriptor);
+    }
+
+    Hardware_Counters(const Hardware_Counters&) = delete;
+    Hardware_Counters& operator=(const Hardware_Counters&) = delete;
+
+    bool valid() const {
+        for ( int descriptor : descriptors )
+            if ( descriptor < 0 ) return false;
+        return true;
+    }
+
+    void start() {
+        if ( !valid() ) return;
+        ioctl(descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    void stop(Instrumentation_Stats& stats) {
+        if ( !valid() ) return;
+        ioctl(descriptors[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        std::uint64_t* fields[] = {&stats.hardware_cycles, &stats.instructions,
+                                   &stats.cache_misses, &stats.branch_misses};
+        for ( int ix = 0; ix < 4; ++ix )
+            if ( read(descriptors[ix], fields[ix], sizeof(std::uint64_t)) != sizeof(std::uint64_t) )
+                return;
+        stats.hardware_valid = true;
+    }
+#else
+public:
+    bool valid() const { return false; }
+    void start() {}
+    void stop(Instrumentation_Stats&) {}
+#endif
+};
+
+/**
+ * Instrumented_Run - resets the stats and measures the wall time (and the hardware counters)
+ * of a run from construction to destruction.
+ */
+class Instrumented_Run {
+    Instrumentation_Stats& stats;
+    Hardware_Counters counters;
+    std::chrono::steady_clock::time_point start;
+public:
+    Instrumented_Run(Instrumentation_Stats& _stats, std::uint64_t nr_trials) : stats(_stats) {
+        stats = Instrumentation_Stats();
+        stats.nr_trials = nr_trials;
+        counters.start();
+        start = std::chrono::steady_clock::now();
+    }
+
+    ~Instrumented_Run() {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        stats.seconds = elapsed.count();
+        counters.stop(stats);
+    }
+
+    Instrumented_Run(const Instrumented_Run&) = delete;
+    Instrumented_Run& operator=(const Instrumented_Run&) = delete;
+};
+
+#endif //MONTECARLO_INSTRUMENTATION_H
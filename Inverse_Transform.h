@@ -0,0 +1,137 @@
+/**
+ * \file Inverse_Transform.h
+ * \date 17-Oct-2026
+ *
+ * \brief Functions relating a value drawn from a standard library distribution to
+ * the uniform variate that produces it by inverse transform.
+ *
+ * \details antithetic_value maps a value x to the value whose cumulative probability
+ * is the complement of that of x, i.e., the value that the inverse CDF would give for
+ * 1-u where x was given for u. For uniform distributions this is lb+ub-x; for the
+ * symmetric distributions it is the reflection around the center. Distributions without
+ * an overload (e.g., bernoulli, poisson) cannot be used in antithetic mode, which shows
+ * up at compile time. Use case is Distribution::mirror_random_values.
+ * inverse_cdf maps a uniform u in (0,1) to a value of the distribution, which lets a
+ * quasi-random point set drive the distributions (Distribution::reload_values_from_uniforms).
+ */
+
+#ifndef MONTECARLO_INVERSE_TRANSFORM_H
+#define MONTECARLO_INVERSE_TRANSFORM_H
+
+#include <random>
+#include <cmath>
+#include <limits>
+
+template <class T>
+T antithetic_value(const std::uniform_real_distribution<T>& distribution, T x) {
+    return distribution.a() + distribution.b() - x;
+}
+
+template <class T>
+T antithetic_value(const std::uniform_int_distribution<T>& distribution, T x) {
+    return distribution.a() + distribution.b() - x;
+}
+
+/**
+ * Exponential: with u = 1 - exp(-lambda x), the antithetic value is -log(u)/lambda. A zero x
+ * (u = 0) is mapped to the largest finite value rather than infinity.
+ */
+template <class T>
+T antithetic_value(const std::exponential_distribution<T>& distribution, T x) {
+    T u = -std::expm1(-distribution.lambda() * x);
+    if ( u <= T(0) ) return std::numeric_limits<T>::max();
+    return -std::log(u) / distribution.lambda();
+}
+
+template <class T>
+T antithetic_value(const std::normal_distribution<T>& distribution, T x) {
+    return distribution.mean() + distribution.mean() - x;
+}
+
+template <class T>
+T antithetic_value(const std::cauchy_distribution<T>& distribution, T x) {
+    return distribution.a() + distribution.a() - x;
+}
+
+template <class T>
+T antithetic_value(const std::lognormal_distribution<T>& distribution, T x) {
+    return std::exp(distribution.m() + distribution.m() - std::log(x));
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * standard_normal_quantile - inverse of the standard normal CDF, Acklam's rational
+ * approximation followed by one Halley step on erfc (close to double precision).
+ * @param u probability in (0,1)
+ */
+inline double standard_normal_quantile(double u) {
+    constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                            1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                            6.680131188771972e+01, -1.328068155288572e+01};
+    constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                            -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                            3.754408661907416e+00};
+    constexpr double u_low = 0.02425;
+    double x;
+    if ( u < u_low ) {
+        double q = std::sqrt(-2.0 * std::log(u));
+        x = (((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+            ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.0);
+    }
+    else if ( u <= 1.0 - u_low ) {
+        double q = u - 0.5;
+        double r = q * q;
+        x = (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5])*q /
+            (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1.0);
+    }
+    else {
+        double q = std::sqrt(-2.0 * std::log1p(-u));
+        x = -(((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) /
+            ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.0);
+    }
+    double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - u;
+    double h = e * std::sqrt(2.0 * 3.14159265358979323846) * std::exp(0.5 * x * x);
+    return x - h / (1.0 + 0.5 * x * h);
+}
+
+template <class T>
+T inverse_cdf(const std::uniform_real_distribution<T>& distribution, double u) {
+    return distribution.a() + static_cast<T>(u) * (distribution.b() - distribution.a());
+}
+
+template <class T>
+T inverse_cdf(const std::uniform_int_distribution<T>& distribution, double u) {
+    double width = static_cast<double>(distribution.b()) - static_cast<double>(distribution.a()) + 1.0;
+    T offset = static_cast<T>(u * width);
+    return offset > distribution.b() - distribution.a() ? distribution.b() : distribution.a() + offset;
+}
+
+template <class T>
+T inverse_cdf(const std::exponential_distribution<T>& distribution, double u) {
+    return static_cast<T>(-std::log1p(-u)) / distribution.lambda();
+}
+
+template <class T>
+T inverse_cdf(const std::normal_distribution<T>& distribution, double u) {
+    return distribution.mean() + distribution.stddev() * static_cast<T>(standard_normal_quantile(u));
+}
+
+template <class T>
+T inverse_cdf(const std::cauchy_distribution<T>& distribution, double u) {
+    return distribution.a() + distribution.b() * static_cast<T>(std::tan(3.14159265358979323846 * (u - 0.5)));
+}
+
+template <class T>
+T inverse_cdf(const std::lognormal_distribution<T>& distribution, double u) {
+    return std::exp(distribution.m() + distribution.s() * static_cast<T>(standard_normal_quantile(u)));
+}
+
+inline bool inverse_cdf(const std::bernoulli_distribution& distribution, double u) {
+    return u < distribution.p();
+}
+
+#endif //MONTECARLO_INVERSE_TRANSFORM_H
@@ -0,0 +1,117 @@
+/**
+ * \file Lazy_Events.h
+ * \date 17-Oct-2026
+ *
+ * \brief Lazy_Events, a view of the events of a Distribution in which each event is drawn
+ * only when it is first accessed in the current trial.
+ *
+ * \details Meant for conditions that look at the first few events and return early: a trial
+ * then costs the events it reads rather than nr_events draws. Every slot carries the stamp
+ * of the trial in which it was drawn, and next_trial() only increments the current stamp, so
+ * starting a trial is O(1) whatever nr_events is. Events are drawn in the order the condition
+ * accesses them, i.e., the random stream is consumed differently than by reload_random_values
+ * (the result is still reproducible for a given seed and condition).
+ * The view keeps pointers to the distribution and to the engine, both must outlive it.
+ * Use case is MonteCarloSimulation::run_lazy.
+ */
+
+#ifndef MONTECARLO_LAZY_EVENTS_H
+#define MONTECARLO_LAZY_EVENTS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Lazy_Events
+ * @tparam DISTRIBUTION - Distribution or Distribution_NTT (anything with draw(URBG&) and get_nr_events())
+ * @tparam URBG - Random engine the events are drawn from
+ */
+template <class DISTRIBUTION, class URBG>
+class Lazy_Events {
+public:
+    using value_type = std::remove_cvref_t<decltype(std::declval<DISTRIBUTION&>().draw(std::declval<URBG&>()))>;
+
+private:
+    DISTRIBUTION* distribution;
+    URBG* dre;
+    std::deque<value_type> values;     ///> not a vector, whose bool specialization has no value_type&
+    std::vector<std::uint32_t> stamps; ///> trial in which each value was drawn
+    std::uint32_t current_trial;       ///> stamp of the current trial, never 0
+    std::size_t nr_drawn;              ///> events drawn in the current trial
+
+public:
+
+    /**
+     * const_iterator - draws the event it points to when dereferenced, so that a range-for loop
+     * with an early break draws only the events it reached.
+     */
+    class const_iterator {
+        Lazy_Events* view;
+        std::size_t index;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename Lazy_Events::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        const_iterator() : view(nullptr), index(0) {}
+        const_iterator(Lazy_Events* _view, std::size_t _index) : view(_view), index(_index) {}
+
+        reference operator*() const { return (*view)[index]; }
+        const_iterator& operator++() { ++index; return *this; }
+        const_iterator operator++(int) { const_iterator previous = *this; ++index; return previous; }
+        friend bool operator==(const const_iterator& a, const const_iterator& b) { return a.index == b.index; }
+    };
+
+    /**
+     * Lazy_Events constructor - the first trial starts with no event drawn.
+     * @param _distribution provides the events through draw(dre)
+     * @param _dre engine the events are drawn from
+     */
+    Lazy_Events(DISTRIBUTION& _distribution, URBG& _dre)
+            : distribution(&_distribution), dre(&_dre),
+              values(_distribution.get_nr_events()), stamps(_distribution.get_nr_events(), 0),
+              current_trial(1), nr_drawn(0) {}
+
+    /**
+     * operator[] - the event at index, drawn now if this is its first access in the trial.
+     */
+    const value_type& operator[](std::size_t index) {
+        if ( stamps[index] != current_trial ) {
+            values[index] = distribution->draw(*dre);
+            stamps[index] = current_trial;
+            ++nr_drawn;
+        }
+        return values[index];
+    }
+
+    /**
+     * next_trial - forgets all events of the current trial, O(1) except once every 2^32 trials.
+     */
+    void next_trial() {
+        if ( ++current_trial == 0 ) {
+            std::fill(stamps.begin(), stamps.end(), 0u);
+            current_trial = 1;
+        }
+        nr_drawn = 0;
+    }
+
+    const_iterator begin() { return const_iterator(this, 0); }
+    const_iterator end() { return const_iterator(this, values.size()); }
+
+    std::size_t size() const { return values.size(); }
+
+    /**
+     * get_nr_drawn - number of events drawn in the current trial.
+     */
+    std::size_t get_nr_drawn() const { return nr_drawn; }
+};
+
+#endif //MONTECARLO_LAZY_EVENTS_H
@@ -17,28 +17,38 @@
 #include <set>
 #include <functional>
 #include <iostream>
+#include <val/montecarlo/Instrumentation.h>
 
-class List_Without_Repetition {
+/**
+ * List_Without_Repetition_T - the condition type is a template parameter (T -> template) so that a
+ * lambda can be inlined into run(). List_Without_Repetition below keeps the std::function version.
+ * @tparam CONDITION - callable as bool(std::deque<int>&, double&)
+ * @tparam ENGINE - UniformRandomBitGenerator used for selection and shuffling
+ */
+template <class CONDITION, class ENGINE = std::default_random_engine>
+class List_Without_Repetition_T {
 
     int nr_trials;
-    std::default_random_engine dre;
+    ENGINE dre;
     std::uniform_int_distribution<int> randomDistribution;
     int nr_events;
     int nr_possible_events;
-    std::function<bool(std::deque<int>&, double&)> condition_met;
+    CONDITION condition_met;
     double interim_value;
     double cumulative_value;
     std::string message;
+    Instrumentation_Stats instrumentation; ///> filled by run if MONTECARLO_INSTRUMENT is defined
 
     /**
      * select_members_from_possible_events - a set is used to randomly select
      * nr_events from the pool of possible events. Once selection is complete,
      * the selected members are then loaded into the events deque.
      */
-    void select_members_from_possible_events() {
+    template <class URBG>
+    void select_members_from_possible_events(URBG& urbg) {
         std::set<int> ordered_events;
         while ( ordered_events.size() < nr_events )
-            ordered_events.insert(randomDistribution(dre));
+            ordered_events.insert(randomDistribution(urbg));
 
         events.clear();  /// out with the old events
 
@@ -48,8 +58,8 @@ class List_Without_Repetition {
 
 public:
 
-    List_Without_Repetition(int _nr_trials, int _nr_events, int _nr_possible_events,
-            std::function<bool(std::deque<int>&, double&)> _condition_met )
+    List_Without_Repetition_T(int _nr_trials, int _nr_events, int _nr_possible_events,
+            CONDITION _condition_met )
             : nr_trials(_nr_trials), randomDistribution(0, _nr_possible_events-1),
             nr_events(_nr_events), nr_possible_events(_nr_possible_events),
               condition_met(std::move(_condition_met)),
@@ -61,26 +71,59 @@ public:
                 events.emplace_back(ix);
         }
         else
-            select_members_from_possible_events();
+            select_members_from_possible_events(dre);
 
         std::shuffle(events.begin(), events.end(), dre);
     }
     
     void reload_random_values() {
+        reload_random_values(dre);
+    }
+
+    /**
+     * reload_random_values - as above, drawing from urbg (e.g., a Counting_Engine over dre).
+     */
+    template <class URBG>
+    void reload_random_values(URBG& urbg) {
         if ( nr_events != nr_possible_events )
-            select_members_from_possible_events();
+            select_members_from_possible_events(urbg);
 
-        std::shuffle(events.begin(), events.end(), dre);
+        std::shuffle(events.begin(), events.end(), urbg);
     }
 
     void run() {
+#ifdef MONTECARLO_INSTRUMENT
+        Instrumented_Run instrumented_run(instrumentation, nr_trials);
+        Counting_Engine<ENGINE> counting_dre(dre);
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            std::uint64_t t0 = cycle_counter();
+            bool met = condition_met(events, interim_value);
+            std::uint64_t t1 = cycle_counter();
+            if ( met )
+                cumulative_value += interim_value;
+            std::uint64_t t2 = cycle_counter();
+            reload_random_values(counting_dre);
+            std::uint64_t t3 = cycle_counter();
+            instrumentation.condition_cycles += t1 - t0;
+            instrumentation.accumulate_cycles += t2 - t1;
+            instrumentation.rng_cycles += t3 - t2;
+        }
+        instrumentation.rng_draws = counting_dre.get_nr_draws();
+#else
         for ( int ix = 0; ix < nr_trials; ++ix ) {
             if ( condition_met(events, interim_value) )
                 cumulative_value += interim_value;
             reload_random_values();
         }
+#endif
     }
 
+    /**
+     * get_instrumentation - phase timings of the last run, all zero unless MONTECARLO_INSTRUMENT
+     * is defined (see Instrumentation.h).
+     */
+    const Instrumentation_Stats& get_instrumentation() const { return instrumentation; }
+
     void print_result() {
         std::cout << message << cumulative_value/static_cast<double>(nr_trials) << '\n';
     }
@@ -94,5 +137,19 @@ public:
     std::deque<int> events;
 };
 
+using List_Without_Repetition = List_Without_Repetition_T<std::function<bool(std::deque<int>&, double&)>>;
+
+/**
+ * make_list_without_repetition - builds a List_Without_Repetition_T with the type of the callable
+ * passed in, e.g., auto lwr = make_list_without_repetition(nr_trials, 5, 10, lambda);
+ * or make_list_without_repetition<PCG64>(...) for another engine.
+ */
+template <class ENGINE = std::default_random_engine, class CONDITION>
+List_Without_Repetition_T<CONDITION, ENGINE> make_list_without_repetition(int nr_trials, int nr_events,
+        int nr_possible_events, CONDITION condition_met) {
+    return List_Without_Repetition_T<CONDITION, ENGINE>(nr_trials, nr_events, nr_possible_events,
+            std::move(condition_met));
+}
+
 #endif //MONTECARLO_LIST_WITHOUT_REPETITION_H
 
@@ -0,0 +1,160 @@
+/**
+ * \file Low_Discrepancy.h
+ * \date 17-Oct-2026
+ *
+ * \brief Sobol low-discrepancy point generator with random linear scrambling and digital shift.
+ *
+ * \details Points are generated in Gray code order from the Joe-Kuo direction numbers
+ * (new-joe-kuo-6.21201) for up to max_dimension dimensions. Each call to randomize
+ * scrambles the sequence anew: the digits of each coordinate are multiplied by a random
+ * lower triangular binary matrix with unit diagonal (Matousek's linear scrambling, applied
+ * to the direction numbers since generation is linear in them) and a random digital shift
+ * is XOR-ed in. This keeps the net structure of the points while making the point set a
+ * random replicate, so that independent replicates give an error estimate, and it breaks the
+ * alignment of the plain sequence that a shift alone keeps. The coordinates
+ * are returned at the center of their 2^-32 cell, i.e., strictly inside (0,1), which
+ * is what the inverse transforms of Inverse_Transform.h need.
+ * Use case is MonteCarloSimulation::run_quasi_random.
+ */
+
+#ifndef MONTECARLO_LOW_DISCREPANCY_H
+#define MONTECARLO_LOW_DISCREPANCY_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+class Sobol_Sequence {
+public:
+    static constexpr int max_dimension = 16;
+    static constexpr int nr_bits = 32;
+
+private:
+    struct Primitive {
+        int degree;                 ///> s, degree of the primitive polynomial
+        std::uint32_t coefficients; ///> a, interior coefficients of the polynomial
+        std::array<std::uint32_t, 6> initial; ///> m_1..m_s
+    };
+
+    /// Dimension 1 is the van der Corput sequence and has no entry.
+    static constexpr std::array<Primitive, max_dimension - 1> primitives {{
+            {1, 0,  {1}},
+            {2, 1,  {1, 3}},
+            {3, 1,  {1, 3, 1}},
+            {3, 2,  {1, 1, 1}},
+            {4, 1,  {1, 1, 3, 3}},
+            {4, 4,  {1, 3, 5, 13}},
+            {5, 2,  {1, 1, 5, 5, 17}},
+            {5, 4,  {1, 1, 5, 5, 5}},
+            {5, 7,  {1, 1, 7, 11, 19}},
+            {5, 11, {1, 1, 5, 1, 1}},
+            {5, 13, {1, 1, 1, 3, 11}},
+            {5, 14, {1, 3, 5, 5, 31}},
+            {6, 1,  {1, 3, 3, 9, 7, 49}},
+            {6, 13, {1, 1, 1, 15, 21, 21}},
+            {6, 16, {1, 3, 1, 13, 27, 49}}
+    }};
+
+    int dimension;
+    std::uint32_t index;                   ///> index of the next point
+    std::vector<std::uint32_t> base_directions; ///> nr_bits direction numbers per dimension
+    std::vector<std::uint32_t> directions; ///> base_directions scrambled for the current replicate
+    std::vector<std::uint32_t> state;      ///> unshifted coordinates of the next point
+    std::vector<std::uint32_t> shift;      ///> digital shift of the current replicate
+
+    /**
+     * scramble - product of the binary matrix (rows[k] is row k, digit k being bit nr_bits-1-k)
+     * with the digits of x.
+     */
+    static std::uint32_t scramble(const std::array<std::uint32_t, nr_bits>& rows, std::uint32_t x) {
+        std::uint32_t y = 0;
+        for ( int kx = 0; kx < nr_bits; ++kx )
+            y |= static_cast<std::uint32_t>(std::popcount(rows[kx] & x) & 1) << (nr_bits - 1 - kx);
+        return y;
+    }
+
+public:
+
+    /**
+     * Sobol_Sequence constructor - builds the direction numbers, unscrambled until randomize is
+     * called; the first point is the origin (before the digital shift).
+     * @param _dimension number of coordinates per point, at most max_dimension
+     */
+    explicit Sobol_Sequence(int _dimension)
+            : dimension(_dimension), index(0),
+              directions(static_cast<std::size_t>(_dimension) * nr_bits),
+              state(_dimension, 0), shift(_dimension, 0) {
+        if ( dimension < 1 || dimension > max_dimension )
+            throw std::out_of_range("Sobol_Sequence: dimension must be in [1, 16]");
+        for ( int bx = 0; bx < nr_bits; ++bx )
+            directions[bx] = std::uint32_t(1) << (nr_bits - 1 - bx);
+        for ( int dx = 1; dx < dimension; ++dx ) {
+            const Primitive& p = primitives[dx - 1];
+            std::uint32_t* v = &directions[static_cast<std::size_t>(dx) * nr_bits];
+            for ( int bx = 0; bx < p.degree; ++bx )
+                v[bx] = p.initial[bx] << (nr_bits - 1 - bx);
+            for ( int bx = p.degree; bx < nr_bits; ++bx ) {
+                v[bx] = v[bx - p.degree] ^ (v[bx - p.degree] >> p.degree);
+                for ( int kx = 1; kx < p.degree; ++kx )
+                    if ( (p.coefficients >> (p.degree - 1 - kx)) & 1u )
+                        v[bx] ^= v[bx - kx];
+            }
+        }
+        base_directions = directions;
+    }
+
+    /**
+     * randomize - restarts the sequence with a new random linear scrambling and digital shift,
+     * giving an independent randomized replicate of the point set.
+     * @param dre engine providing the scrambling matrices and the shift
+     */
+    template <class URBG>
+    void randomize(URBG& dre) {
+        std::uniform_int_distribution<std::uint32_t> word(0, UINT32_MAX);
+        std::array<std::uint32_t, nr_bits> rows;
+        for ( int dx = 0; dx < dimension; ++dx ) {
+            for ( int kx = 0; kx < nr_bits; ++kx ) {
+                std::uint32_t diagonal = std::uint32_t(1) << (nr_bits - 1 - kx);
+                std::uint32_t above = ~(diagonal | (diagonal - 1));    ///> more significant digits
+                rows[kx] = (word(dre) & above) | diagonal;
+            }
+            std::size_t first = static_cast<std::size_t>(dx) * nr_bits;
+            for ( int bx = 0; bx < nr_bits; ++bx )
+                directions[first + bx] = scramble(rows, base_directions[first + bx]);
+        }
+        for ( std::uint32_t& s : shift )
+            s = word(dre);
+        restart();
+    }
+
+    /**
+     * restart - back to the first point, keeping the current scrambling and shift.
+     */
+    void restart() {
+        index = 0;
+        std::fill(state.begin(), state.end(), 0u);
+    }
+
+    /**
+     * next - writes the next point and advances the sequence.
+     * @param point dimension coordinates in (0,1)
+     */
+    void next(std::span<double> point) {
+        constexpr double scale = 1.0 / 4294967296.0; ///> 2^-32
+        for ( int dx = 0; dx < dimension; ++dx )
+            point[dx] = (static_cast<double>(state[dx] ^ shift[dx]) + 0.5) * scale;
+        int bx = std::countr_one(index);  ///> Gray code: flip the rightmost zero bit of index
+        for ( int dx = 0; dx < dimension; ++dx )
+            state[dx] ^= directions[static_cast<std::size_t>(dx) * nr_bits + bx];
+        ++index;
+    }
+
+    int get_dimension() const { return dimension; }
+};
+
+#endif //MONTECARLO_LOW_DISCREPANCY_H
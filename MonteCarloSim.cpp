@@ -2,10 +2,13 @@
  * \file MonteCarloSim.cpp
  * \date 29-Jun-2017
  *
- * \brief empty cpp file for compiling purposes only
+ * \brief cpp file for compiling purposes: includes every header, and main runs the
+ * fixed-size events (Distribution_Fixed, Distribution_NTT_Fixed) through every runner so that
+ * all of them are compiled, and checked, for std::array events.
  *
  */
 
+#define MONTECARLO_MULTI_PROCESS   // compile run_processes too
 #include <val/montecarlo/MonteCarloSim_beta.h>
 #include <val/montecarlo/Differences.h>
 #include <val/montecarlo/Distribution_beta.h>
@@ -13,8 +16,144 @@
 #include <val/montecarlo/StateMatrix.h>
 #include <val/montecarlo/List_Without_Repetition.h>
 #include <val/montecarlo/Combinatorics.h>
+#include <val/montecarlo/Event_Batch.h>
+#include <val/montecarlo/Statistics.h>
+#include <val/montecarlo/Inverse_Transform.h>
+#include <val/montecarlo/Low_Discrepancy.h>
+#include <val/montecarlo/Checkpoint.h>
+#include <val/montecarlo/Random_Engines.h>
+#include <val/montecarlo/Bulk_Uniform.h>
+#include <val/montecarlo/Contiguous_Events.h>
+#include <val/montecarlo/Parameter_Sweep.h>
+#include <val/montecarlo/Lazy_Events.h>
+#include <val/montecarlo/Instrumentation.h>
+#include <val/montecarlo/Trial_Sink.h>
+#include <val/montecarlo/Multi_Process.h>
+#include <val/montecarlo/Async_Run.h>
+#include <val/montecarlo/Ziggurat.h>
+#include <val/montecarlo/Alias_Table.h>
+#include <val/montecarlo/Bernoulli_Bits.h>
+#include <val/montecarlo/Fast_Poisson.h>
+#include <val/montecarlo/Histogram_Shards.h>
 
-int main() {
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+
+namespace {
+
+constexpr int fixed_nr_trials = 60000;
+
+/**
+ * check_seven - whether result is the probability of two dice summing to 7 (1/6), within six
+ * standard errors of fixed_nr_trials trials; prints the runner otherwise.
+ */
+bool check_seven(const char* runner, double result) {
+    double standard_error = std::sqrt(5.0 / 36.0 / fixed_nr_trials);
+    if ( std::abs(result - 1.0 / 6.0) <= 6.0 * standard_error )
+        return true;
+    std::printf("fixed events: %s gives %g instead of 1/6\n", runner, result);
+    return false;
+}
+
+/**
+ * run_fixed_events - two dice summing to 7 through every runner of MonteCarloSimulation,
+ * MonteCarloSimulation_NTT and Parameter_Sweep with std::array events.
+ * @return number of runners with a wrong result
+ */
+int run_fixed_events() {
+    using Two_Dice = Distribution_Fixed<int, int, std::uniform_int_distribution, 2>;
+    using Two_Dice_NTT = Distribution_NTT_Fixed<int, int, std::uniform_int_distribution<int>, 2>;
+    Histogram<int, int> sums(0, 12, 1);
+    Histogram_Shards<int, int> shards(sums, 2);
+    auto seven = [&shards](auto& dist, int& value, auto&) {
+        shards.local().increment_if_in_range(dist.events[0] + dist.events[1]);
+        value = 1;
+        return dist.events[0] + dist.events[1] == 7;
+    };
+    auto simulation = [&seven]() {
+        Two_Dice two_dice(1, 6, 2);
+        return make_monte_carlo_simulation<int, Xoshiro256StarStar>(fixed_nr_trials, 11, seven, two_dice);
+    };
+    auto simulation_ntt = [&seven]() {
+        Two_Dice_NTT two_dice(1, 6, 2);
+        return make_monte_carlo_simulation<int, Xoshiro256StarStar>(fixed_nr_trials, 11, seven, two_dice);
+    };
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    int nr_failed = 0;
+
+    { auto s = simulation(); s.run(); nr_failed += !check_seven("run", s.return_result()); }
+    { auto s = simulation(); s.run_trials(); nr_failed += !check_seven("run_trials", s.return_result()); }
+    { auto s = simulation(); s.run_async().wait(); nr_failed += !check_seven("run_async", s.return_result()); }
+    { auto s = simulation(); s.select_quasi_random(4); s.run();
+      nr_failed += !check_seven("run_quasi_random", s.return_result()); }
+    { auto s = simulation();
+      std::filesystem::path file = directory / "montecarlo_fixed_events.ckpt";
+      std::filesystem::remove(file);
+      Checkpoint checkpoint(file.string(), 10000);
+      s.run_with_checkpoints(checkpoint);
+      std::filesystem::remove(file);
+      nr_failed += !check_seven("run_with_checkpoints", s.return_result()); }
+    { auto s = simulation(); s.run_parallel(2); nr_failed += !check_seven("run_parallel", s.return_result()); }
+    { auto s = simulation(); shards.clear(); sums.clear_amounts(); s.run_parallel(2, shards);
+      nr_failed += !check_seven("run_parallel with shards", s.return_result());
+      nr_failed += !check_seven("Histogram_Shards", static_cast<double>(sums.get_amount(7)) / fixed_nr_trials); }
+#if defined(MONTECARLO_MULTI_PROCESS) && defined(MONTECARLO_HAS_FORK)
+    { auto s = simulation(); s.run_processes(2); nr_failed += !check_seven("run_processes", s.return_result()); }
+#endif
+    { auto s = simulation();
+      s.run_batched(1000, [](std::span<int> events, int& value, auto&) { value = 1; return events[0] + events[1] == 7; });
+      nr_failed += !check_seven("run_batched", s.return_result()); }
+    { auto s = simulation();
+      s.run_lazy([](auto& events, int& value, auto&) { value = 1; return events[0] + events[1] == 7; });
+      nr_failed += !check_seven("run_lazy", s.return_result()); }
+    { auto s = simulation();
+      std::filesystem::path file = directory / "montecarlo_fixed_events.trials";
+      {
+          Trial_Sink<int> sink(file.string(), 3);
+          s.run_with_sink(sink, [](auto& dist, std::span<int> summary) {
+              summary[0] = dist.events[0];
+              summary[1] = dist.events[1];
+          });
+          sink.close();
+      }
+      std::filesystem::remove(file);
+      nr_failed += !check_seven("run_with_sink", s.return_result()); }
+    { auto s = simulation();
+      const Running_Moments& moments = s.run_estimators<1>([](auto& dist, std::array<double, 1>& outcomes, auto&) {
+          outcomes[0] = dist.events[0] + dist.events[1] == 7; });
+      nr_failed += !check_seven("run_estimators", moments.mean(0)); }
+    { auto s = simulation(); s.run_to_precision(Precision_Target::Absolute_Standard_Error, 0.01, fixed_nr_trials);
+      nr_failed += !check_seven("run_to_precision", s.return_result()); }
+    { auto s = simulation(); s.run_antithetic(); nr_failed += !check_seven("run_antithetic", s.return_result()); }
+    { auto s = simulation();
+      s.add_control_variate([](auto& dist) { return static_cast<double>(dist.events[0]); }, 3.5);
+      s.run_with_control_variates();
+      nr_failed += !check_seven("run_with_control_variates", s.return_controlled_result()); }
+
+    { auto s = simulation_ntt(); s.run(); nr_failed += !check_seven("NTT run", s.return_result()); }
+    { auto s = simulation_ntt(); s.run_trials(); nr_failed += !check_seven("NTT run_trials", s.return_result()); }
+    { auto s = simulation_ntt(); s.run_async().wait(); nr_failed += !check_seven("NTT run_async", s.return_result()); }
+    { auto s = simulation_ntt(); s.run_parallel(2); nr_failed += !check_seven("NTT run_parallel", s.return_result()); }
+#if defined(MONTECARLO_MULTI_PROCESS) && defined(MONTECARLO_HAS_FORK)
+    { auto s = simulation_ntt(); s.run_processes(2); nr_failed += !check_seven("NTT run_processes", s.return_result()); }
+#endif
 
-    return 0;
+    auto sweep = make_parameter_sweep<int, Xoshiro256StarStar>(std::vector<int>{6, 6}, [](int faces) {
+        return std::make_pair(Two_Dice_NTT(1, faces, 2),
+                [](Two_Dice_NTT& dist, int& value, Xoshiro256StarStar&) {
+                    value = 1;
+                    return dist.events[0] + dist.events[1] == 7; });
+    }, fixed_nr_trials, 11);
+    sweep.run(2);
+    for ( const Sweep_Result<int>& row : sweep.get_results() )
+        nr_failed += !check_seven("Parameter_Sweep", row.result);
+    return nr_failed;
+}
+
+} // namespace
+
+int main() {
+    return run_fixed_events() == 0 ? 0 : 1;
 }
@@ -20,18 +20,21 @@
  * methods increment_interim_value and assign_interim_value are deprecated.
  * @tparam T - For the primary distribution, expected to be either integral or floating point.
  * @tparam U - For the secondary distribution, expected to be either integral or floating point.
+ * @tparam EVENTS1, EVENTS2 - Containers of the events of the two distributions (std::deque or Contiguous_Events)
+ * @tparam CONDITION - Type of condition_met; defaults to std::function, a lambda type lets it be inlined.
  */
-template <class T, class U, DistributionType D1, DistributionType D2>
+template <class T, class U, DistributionType D1, DistributionType D2,
+        class EVENTS1 = std::deque<T>, class EVENTS2 = std::deque<U>,
+        class CONDITION = std::function<bool(Distribution<T, D1, EVENTS1>&, Distribution<U, D2, EVENTS2>&, double&)>>
 class MonteCarloSimulation {
 protected:
     int nr_trials;
     double cumulative_value;
     double interim_value;
     std::string message;
-    Distribution<T, D1> primary_distribution;
-    Distribution<U, D2> secondary_distribution;
-    std::function<bool(Distribution<T, D1>&,
-            Distribution<U, D2>&, double&)> condition_met;
+    Distribution<T, D1, EVENTS1> primary_distribution;
+    Distribution<U, D2, EVENTS2> secondary_distribution;
+    CONDITION condition_met;
 public:
 
     /**
@@ -59,8 +62,7 @@ public:
      * @param seed_secondary - Seed for the random number generator for the secondary distribution
      */
     MonteCarloSimulation( int _nr_trials,
-            std::function<bool(Distribution<T, D1>&,
-                    Distribution<U, D2>&, double&)> _condition_met,
+            CONDITION _condition_met,
             T _lb_primary, T _ub_primary, int nr_events_primary, int seed_primary,
             U _lb_secondary, U _ub_secondary, int nr_events_secondary, int seed_secondary )
             : nr_trials(_nr_trials), cumulative_value(0.0),
@@ -79,10 +81,9 @@ public:
      * @param _secondary_distribution - Secondary distribution.
      */
     MonteCarloSimulation( int _nr_trials,
-            std::function<bool(Distribution<T, D1>&,
-                    Distribution<U, D2>&, double&)> _condition_met,
-            Distribution<T, D1>& _primary_distribution,
-            Distribution<U, D2>& _secondary_distribution )
+            CONDITION _condition_met,
+            Distribution<T, D1, EVENTS1>& _primary_distribution,
+            Distribution<U, D2, EVENTS2>& _secondary_distribution )
             : nr_trials(_nr_trials), cumulative_value(0.0),
               interim_value(1.0), message("probability is = "),
               condition_met(_condition_met),
@@ -98,6 +99,14 @@ public:
      * interim_value. Lastly, within the loop, the primary distribution is reset to new random values.
      */
     virtual void run() {
+        run_trials();
+    }
+
+    /**
+     * run_trials - non-virtual body of run(), so that a call on the concrete type (together
+     * with a lambda CONDITION) lets the whole trial be inlined.
+     */
+    void run_trials() {
         for ( int ix = 0; ix < nr_trials; ++ix ) {
             if ( condition_met(primary_distribution, secondary_distribution, interim_value) )
                 cumulative_value += interim_value;
@@ -147,23 +156,26 @@ public:
  * @tparam T - For the x-axis or domain of the distribution, expected to be either integral or floating point.
  * @tparam U - For the y-axis or range of the distribution, expected to be either integral or floating point.
  * @tparam D - DistributionType (e.g., UniformIntegral, UniformReal)
+ * @tparam EVENTS - Container of the distribution's events (std::deque or Contiguous_Events)
+ * @tparam CONDITION - Type of condition_met; defaults to std::function, a lambda type lets it be inlined.
  * */
 
-template <class T, class U, DistributionType D>
+template <class T, class U, DistributionType D, class EVENTS = std::deque<T>,
+        class CONDITION = std::function<bool(Distribution<T, D, EVENTS>&, U&)>>
 class MonteCarloSimulation_alpha {
 protected:
     int nr_trials;
     U cumulative_value;
     U interim_value;
     std::string message;
-    Distribution<T, D> distribution;
-    std::function<bool(Distribution<T, D>&, U&)> condition_met;
+    Distribution<T, D, EVENTS> distribution;
+    CONDITION condition_met;
 
 public:
 
     MonteCarloSimulation_alpha ( int _nr_trials,
-            std::function<bool(Distribution<T, D>&, U&)> _condition_met,
-            Distribution<T, D>& _distribution )
+            CONDITION _condition_met,
+            Distribution<T, D, EVENTS>& _distribution )
             : nr_trials(_nr_trials), cumulative_value(0),
             interim_value(1), message("probability is = "),
             condition_met(_condition_met),
@@ -171,6 +183,10 @@ public:
     }
 
     virtual void run() {
+        run_trials();
+    }
+
+    void run_trials() {
         for ( int ix = 0; ix < nr_trials; ++ix ) {
             if ( condition_met(distribution, interim_value) )
                 cumulative_value += interim_value;
@@ -190,4 +206,29 @@ public:
     }
 };
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * make_monte_carlo_simulation - builds a MonteCarloSimulation from two declared distributions
+ * with CONDITION deduced from the callable (typically a lambda) instead of std::function.
+ */
+template <class T, class U, DistributionType D1, DistributionType D2, class EVENTS1, class EVENTS2, class CONDITION>
+MonteCarloSimulation<T, U, D1, D2, EVENTS1, EVENTS2, CONDITION>
+make_monte_carlo_simulation(int nr_trials, CONDITION condition_met,
+        Distribution<T, D1, EVENTS1>& primary_distribution, Distribution<U, D2, EVENTS2>& secondary_distribution) {
+    return MonteCarloSimulation<T, U, D1, D2, EVENTS1, EVENTS2, CONDITION>(nr_trials, std::move(condition_met),
+            primary_distribution, secondary_distribution);
+}
+
+/**
+ * make_monte_carlo_simulation_alpha - builds a MonteCarloSimulation_alpha with CONDITION deduced
+ * from the callable; only U (the y-axis type) has to be given.
+ */
+template <class U, class T, DistributionType D, class EVENTS, class CONDITION>
+MonteCarloSimulation_alpha<T, U, D, EVENTS, CONDITION>
+make_monte_carlo_simulation_alpha(int nr_trials, CONDITION condition_met, Distribution<T, D, EVENTS>& distribution) {
+    return MonteCarloSimulation_alpha<T, U, D, EVENTS, CONDITION>(nr_trials, std::move(condition_met), distribution);
+}
+
 #endif //MONTECARLO_MONTECARLOSIM_H
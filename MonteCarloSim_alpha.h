@@ -23,18 +23,20 @@ using DRE = std::default_random_engine;
  * @tparam T - For the x-axis or domain of the distribution, expected to be either integral or floating point.
  * @tparam U - For the y-axis or range of the distribution, expected to be either integral or floating point.
  * @tparam D - DistributionType (e.g., UniformIntegral, UniformReal)
+ * @tparam EVENTS - Container of the distribution's events (std::deque or Contiguous_Events)
+ * @tparam ENGINE - Random engine (UniformRandomBitGenerator), std::default_random_engine by default
  */
 
-template <class T, class U, DistributionType D>
+template <class T, class U, DistributionType D, class EVENTS = std::deque<T>, class ENGINE = DRE>
 class MonteCarloSimulation {
 protected:
     int nr_trials; ///> number of repeated trials run for the simulation
-    DRE dre;			///> default random engine (random number generator)
+    ENGINE dre;			///> random engine (random number generator)
     U cumulative_value; ///> accumulates the interim value for nr_trials
     U interim_value;		///> value determined for each trial
     std::string message; ///> message can be changed to match the meaning of cumulative_value/nr_trials
-    Distribution<T, D> distribution; ///> (e.g., real) and deque of numbers selected from it
-    std::function<bool(Distribution<T, D>&, U&, DRE&)> condition_met; ///> function containing particulars of the simulation
+    Distribution<T, D, EVENTS> distribution; ///> (e.g., real) and deque of numbers selected from it
+    std::function<bool(Distribution<T, D, EVENTS>&, U&, ENGINE&)> condition_met; ///> function containing particulars of the simulation
 
 public:
 
@@ -48,8 +50,8 @@ public:
      * @param _distribution (e.g., real) and deque of numbers selected from it
      */
     MonteCarloSimulation ( int _nr_trials, int _seed,
-            std::function<bool(Distribution<T, D>&, U&, DRE&)> _condition_met,
-            Distribution<T, D>& _distribution )
+            std::function<bool(Distribution<T, D, EVENTS>&, U&, ENGINE&)> _condition_met,
+            Distribution<T, D, EVENTS>& _distribution )
             : nr_trials(_nr_trials), dre(_seed),
               cumulative_value(0), interim_value(1),
               message("probability is = "),
@@ -13,10 +13,38 @@
 #include <iostream>
 #include <vector>
 #include <random>
+#include <thread>
+#include <exception>
+#include <algorithm>
+#include <span>
+#include <array>
+#include <stdexcept>
 #include <val/montecarlo/Distribution_beta.h>
+#include <val/montecarlo/Statistics.h>
+#include <val/montecarlo/Low_Discrepancy.h>
+#include <val/montecarlo/Lazy_Events.h>
+#include <val/montecarlo/Instrumentation.h>
+#include <val/montecarlo/Trial_Sink.h>
+#ifdef MONTECARLO_MULTI_PROCESS    // opt-in, brings in the POSIX headers (see Multi_Process.h)
+#include <val/montecarlo/Multi_Process.h>
+#endif
+#include <val/montecarlo/Async_Run.h>
+#include <val/montecarlo/Histogram_Shards.h>
 
 using DRE = std::default_random_engine;
 
+/**
+ * Precision_Target enum class - selects what run_to_precision compares its target against
+ * - Absolute_Standard_Error: standard error of the result
+ * - Relative_Standard_Error: standard error divided by the magnitude of the result
+ * - Confidence_Half_Width: z times the standard error (e.g., z = 1.96 for 95%)
+ */
+enum class Precision_Target {
+    Absolute_Standard_Error,
+    Relative_Standard_Error,
+    Confidence_Half_Width
+};
+
 /**
  * MonteCarloSimulation Class, consists of Constructor and the methods: run, change_message, and
  * print_result. This is a reworking of the original MonteCarloSim class. The main differences are the
@@ -25,18 +53,34 @@ using DRE = std::default_random_engine;
  * @tparam Y_AXIS - For the y-axis or range of the distribution, expected to be either integral or floating point.
  * @tparam PARAM - Input parameter type, e.g, for Poisson it is of real type even though values T are integral
  * @tparam STD_DIST - A template template of the Distribution - when object created, e.g., std::uniform_int_distribution
+ * @tparam EVENTS - Container of the distribution's events, std::deque or Contiguous_Events
+ * @tparam ENGINE - Random engine (UniformRandomBitGenerator), e.g., std::mt19937_64, PCG64, Xoshiro256StarStar
+ * @tparam CONDITION - Type of condition_met; defaults to std::function, a lambda type lets run_trials inline it
  */
 
-template <class X_AXIS, class Y_AXIS, class PARAM, template <class> class STD_DIST>
+template <class X_AXIS, class Y_AXIS, class PARAM, template <class> class STD_DIST,
+        class EVENTS = std::deque<X_AXIS>, class ENGINE = DRE,
+        class CONDITION = std::function<bool(Distribution<X_AXIS, PARAM, STD_DIST, EVENTS>&, Y_AXIS&, ENGINE&)>>
 class MonteCarloSimulation {
 protected:
     int nr_trials; ///> number of repeated trials run for the simulation
-    DRE dre;			///> default random engine
+    int seed;       ///> seed of dre, also the root of the per-worker streams in run_parallel
+    ENGINE dre;			///> random engine, std::default_random_engine unless ENGINE is given
     Y_AXIS cumulative_value; ///> accumulates the interim value for nr_trials
     Y_AXIS interim_value;		///> value determined for each trial
     std::string message; ///> message can be changed to match the meaning of cumulative_value/nr_trials
-    Distribution<X_AXIS, PARAM, STD_DIST> distribution; ///> (e.g., real) and deque of numbers selected from it
-    std::function<bool(Distribution<X_AXIS, PARAM, STD_DIST>&, Y_AXIS&, DRE&)> condition_met; ///> function containing particulars of the simulation
+    Distribution<X_AXIS, PARAM, STD_DIST, EVENTS> distribution; ///> (e.g., real) and deque of numbers selected from it
+    CONDITION condition_met; ///> function containing particulars of the simulation
+    Running_Statistics trial_statistics; ///> per-trial values seen by run_to_precision
+    double variance_reduction; ///> variance reduction factor of the last run_antithetic
+    std::vector<std::function<double(Distribution<X_AXIS, PARAM, STD_DIST, EVENTS>&)>> controls; ///> control variates
+    std::vector<double> control_means; ///> known expectations of the controls
+    Running_Moments control_moments; ///> trial value (component 0) and controls of run_with_control_variates
+    int nr_replicates; ///> zero for pseudo-random sampling, else number of quasi-random replicates
+    Running_Statistics replicate_statistics; ///> replicate means seen by run_quasi_random
+    Running_Moments estimator_moments; ///> outcomes of the trials of run_estimators
+    std::uint64_t nr_events_consumed; ///> events drawn by run_lazy
+    Instrumentation_Stats instrumentation; ///> filled by run_trials if MONTECARLO_INSTRUMENT is defined
 
 public:
 
@@ -50,13 +94,16 @@ public:
      * @param _distribution (e.g., real) and deque of numbers selected from it
      */
     MonteCarloSimulation ( int _nr_trials, int _seed,
-            std::function<bool(Distribution<X_AXIS, PARAM, STD_DIST>&, Y_AXIS&, DRE&)> _condition_met,
-            Distribution<X_AXIS, PARAM, STD_DIST>& _distribution )
-            : nr_trials(_nr_trials), dre(_seed),
+            CONDITION _condition_met,
+            Distribution<X_AXIS, PARAM, STD_DIST, EVENTS>& _distribution )
+            : nr_trials(_nr_trials), seed(_seed), dre(_seed),
               cumulative_value(0), interim_value(1),
               message("probability is = "),
+              distribution(std::move(_distribution)),
               condition_met(_condition_met),
-              distribution(std::move(_distribution))
+              variance_reduction(1.0),
+              nr_replicates(0),
+              nr_events_consumed(0)
     {
         distribution.load_random_values(dre);
     }
@@ -66,11 +113,590 @@ public:
      * functions were changed to accept dre from here.
      */
     virtual void run() {
+        if ( nr_replicates > 0 )
+            run_quasi_random();
+        else
+            run_trials();
+    }
+
+    /**
+     * run_trials - non-virtual body of run(), so that a call on the concrete type (together
+     * with a lambda CONDITION) lets the whole trial be inlined.
+     */
+    void run_trials() {
+#ifdef MONTECARLO_INSTRUMENT
+        Instrumented_Run instrumented_run(instrumentation, nr_trials);
+        Counting_Engine<ENGINE> counting_dre(dre);
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            std::uint64_t t0 = cycle_counter();
+            bool met = condition_met(distribution, interim_value, dre);
+            std::uint64_t t1 = cycle_counter();
+            if ( met )
+                cumulative_value += interim_value;
+            std::uint64_t t2 = cycle_counter();
+            distribution.reload_random_values(counting_dre);
+            std::uint64_t t3 = cycle_counter();
+            instrumentation.condition_cycles += t1 - t0;
+            instrumentation.accumulate_cycles += t2 - t1;
+            instrumentation.rng_cycles += t3 - t2;
+        }
+        instrumentation.rng_draws = counting_dre.get_nr_draws();
+#else
         for ( int ix = 0; ix < nr_trials; ++ix ) {
             if ( condition_met(distribution, interim_value, dre) )
                 cumulative_value += interim_value;
             distribution.reload_random_values(dre);
         }
+#endif
+    }
+
+    /**
+     * get_instrumentation - phase timings of the last run_trials, all zero unless
+     * MONTECARLO_INSTRUMENT is defined (see Instrumentation.h).
+     */
+    const Instrumentation_Stats& get_instrumentation() const { return instrumentation; }
+
+    /**
+     * run_async - runs the trials of run_trials() on a background thread and returns at once.
+     * The handle reports the trials done, the estimate and the throughput, and can cancel the
+     * run, after which nr_trials holds the trials done and return_result() the partial result.
+     * Run to the end, the result is the same as that of run_trials(). The simulation must
+     * outlive the handle and must not be used otherwise until the run has finished.
+     * @param callback called on the run thread with the progress every interval, and once at the end
+     * @param interval minimum time between two calls of callback
+     * @param chunk_trials trials between two updates of the progress, at least one
+     */
+    Async_Run run_async(Progress_Callback callback = {},
+            std::chrono::milliseconds interval = std::chrono::milliseconds(1000), int chunk_trials = 4096) {
+        return launch_async_run(static_cast<std::uint64_t>(nr_trials), chunk_trials, interval, std::move(callback),
+                [this](int count) {
+                    for ( int ix = 0; ix < count; ++ix ) {
+                        if ( condition_met(distribution, interim_value, dre) )
+                            cumulative_value += interim_value;
+                        distribution.reload_random_values(dre);
+                    }
+                    return static_cast<double>(cumulative_value);
+                },
+                [this](std::uint64_t nr_trials_done) { nr_trials = static_cast<int>(nr_trials_done); });
+    }
+
+    /**
+     * select_quasi_random - makes run() draw the events from a scrambled Sobol sequence (one
+     * coordinate per event, by inverse transform) instead of dre. Suited to a small nr_events;
+     * dre still drives the scrambling and anything condition_met draws itself.
+     * @param _nr_replicates number of independently scrambled replicates, at least two for an
+     * error estimate; zero returns to pseudo-random sampling
+     */
+    void select_quasi_random(int _nr_replicates) {
+        nr_replicates = _nr_replicates;
+    }
+
+    /**
+     * run_quasi_random - splits nr_trials into nr_replicates scrambled Sobol point sets. The
+     * result is the mean over all points (as for run()), its standard error is estimated from
+     * the spread of the replicate means of this run. nr_trials is rounded down to a multiple of
+     * the number of replicates, and must be at least that number (std::invalid_argument is
+     * thrown otherwise).
+     */
+    void run_quasi_random() {
+        int replicates = nr_replicates > 0 ? nr_replicates : 1;
+        if ( nr_trials < replicates )
+            throw std::invalid_argument("run_quasi_random: fewer trials than replicates");
+        int points_per_replicate = nr_trials / replicates;
+        replicate_statistics = Running_Statistics();
+        Sobol_Sequence sobol(distribution.get_nr_events());
+        std::vector<double> point(distribution.get_nr_events());
+        for ( int rx = 0; rx < replicates; ++rx ) {
+            sobol.randomize(dre);
+            Y_AXIS replicate_value = 0;
+            for ( int ix = 0; ix < points_per_replicate; ++ix ) {
+                sobol.next(point);
+                distribution.reload_values_from_uniforms(point);
+                if ( condition_met(distribution, interim_value, dre) )
+                    replicate_value += interim_value;
+            }
+            cumulative_value += replicate_value;
+            replicate_statistics.add(static_cast<double>(replicate_value) / static_cast<double>(points_per_replicate));
+        }
+        nr_trials = replicates * points_per_replicate;
+    }
+
+    /**
+     * quasi_random_standard_error - standard error of return_result() after run_quasi_random,
+     * from the replicate means.
+     */
+    double quasi_random_standard_error() const { return replicate_statistics.standard_error(); }
+
+    /**
+     * run_with_checkpoints - as run(), but saves the state of the simulation every
+     * checkpoint.get_interval() trials. If the checkpoint file exists when called, the run
+     * resumes from it and gives the same result as an uninterrupted run (provided condition_met
+     * keeps no state of its own other than what is attached to the checkpoint).
+     * @param checkpoint file, interval and attached objects (e.g., a Histogram being filled)
+     */
+    void run_with_checkpoints(Checkpoint& checkpoint) {
+        int ix = 0;
+        if ( checkpoint.exists() )
+            checkpoint.load([this, &ix](std::istream& i) {
+                read_binary(i, ix);
+                read_binary(i, cumulative_value);
+                read_binary(i, interim_value);
+                read_stream_state(i, dre);
+                distribution.read_state(i);
+            });
+        while ( ix < nr_trials ) {
+            int last = ix + std::min(checkpoint.get_interval(), nr_trials - ix);
+            for ( ; ix < last; ++ix ) {
+                if ( condition_met(distribution, interim_value, dre) )
+                    cumulative_value += interim_value;
+                distribution.reload_random_values(dre);
+            }
+            checkpoint.save([this, ix](std::ostream& o) {
+                write_binary(o, ix);
+                write_binary(o, cumulative_value);
+                write_binary(o, interim_value);
+                write_stream_state(o, dre);
+                distribution.write_state(o);
+            });
+        }
+    }
+
+    /**
+     * run_parallel - splits the nr_trials over nr_threads workers. Each worker runs on its own
+     * copy of the distribution and of condition_met, with its own engine seeded from
+     * (seed, worker index) through std::seed_seq so that the streams are independent. The
+     * worker sums are added to cumulative_value in worker order once all of them are joined,
+     * so the result is reproducible for a given seed and number of threads (it is not the
+     * same as the result of the single-threaded run()).
+     * Note that condition_met must not share mutable state between the copies (e.g., through
+     * a reference capture), since the copies are called concurrently; a histogram is filled
+     * through Histogram_Shards (see the overload below).
+     * @param nr_threads number of worker threads, at least one (std::invalid_argument is thrown
+     * otherwise)
+     */
+    virtual void run_parallel(int nr_threads) {
+        if ( nr_threads < 1 )
+            throw std::invalid_argument("run_parallel: at least one thread is needed");
+        std::vector<Y_AXIS> worker_values(nr_threads, Y_AXIS(0));
+        std::vector<std::exception_ptr> worker_errors(nr_threads);
+        std::vector<std::thread> workers;
+        for ( int wx = 0; wx < nr_threads; ++wx )
+            workers.emplace_back([this, wx, nr_threads, &worker_values, &worker_errors]() {
+                try {
+                    worker_values[wx] = run_worker(wx, nr_threads);
+                }
+                catch (...) {
+                    worker_errors[wx] = std::current_exception();
+                }
+            });
+        for ( std::thread& worker : workers )
+            worker.join();
+        for ( std::exception_ptr& error : worker_errors )
+            if ( error ) std::rethrow_exception(error);
+        for ( Y_AXIS value : worker_values )
+            cumulative_value += value;
+    }
+
+    /**
+     * run_parallel - as above, with condition_met filling shards.local(); the shards are merged
+     * into their histogram once the workers are joined.
+     * @param nr_threads number of worker threads, at most shards.get_nr_shards()
+     * @param shards per-worker amounts of the histogram filled by condition_met
+     */
+    template <class T, class U>
+    void run_parallel(int nr_threads, Histogram_Shards<T,U>& shards) {
+        if ( nr_threads > shards.get_nr_shards() )
+            throw std::invalid_argument("run_parallel: fewer histogram shards than threads");
+        run_parallel(nr_threads);
+        shards.merge();
+    }
+
+    /**
+     * run_worker - runs the share of nr_trials belonging to worker (the first
+     * nr_trials % nr_workers workers take one extra trial).
+     * @param worker index of the worker, also selects its random number stream
+     * @param nr_workers total number of workers
+     * @return accumulated interim values of this worker
+     */
+    Y_AXIS run_worker(int worker, int nr_workers) const {
+        int worker_trials = nr_trials / nr_workers + (worker < nr_trials % nr_workers ? 1 : 0);
+        Histogram_Shard_Scope shard_scope(worker);
+        std::seed_seq worker_seeds{seed, worker};
+        ENGINE worker_dre(worker_seeds);
+        auto worker_distribution = distribution;
+        auto worker_condition = condition_met;
+        Y_AXIS worker_interim = interim_value;
+        Y_AXIS worker_cumulative = 0;
+        worker_distribution.reload_random_values(worker_dre);
+        for ( int ix = 0; ix < worker_trials; ++ix ) {
+            if ( worker_condition(worker_distribution, worker_interim, worker_dre) )
+                worker_cumulative += worker_interim;
+            worker_distribution.reload_random_values(worker_dre);
+        }
+        return worker_cumulative;
+    }
+
+#if defined(MONTECARLO_MULTI_PROCESS) && defined(MONTECARLO_HAS_FORK)
+    /**
+     * run_processes - like run_parallel, but each worker runs in a forked process and the worker
+     * sums are reduced through shared memory (see Multi_Process.h). The workers are the same as
+     * those of run_parallel, so the result equals run_parallel(nr_processes) for the same seed.
+     * Note that this is not the result of run() for that seed: each worker draws from its own
+     * stream, seeded from (seed, worker index), since the serial stream cannot be split into
+     * trial ranges when condition_met may draw from dre itself. Only compiled with
+     * MONTECARLO_MULTI_PROCESS defined.
+     * @param nr_processes number of worker processes
+     */
+    void run_processes(int nr_processes) {
+        Process_Reduction no_reduction;
+        run_processes(nr_processes, no_reduction);
+    }
+
+    /**
+     * run_processes - as above, and also adds up the objects attached to reduction (e.g., a
+     * histogram filled by condition_met) over the workers into the launching process' objects.
+     * @param nr_processes number of worker processes
+     * @param reduction objects filled by condition_met, cleared in each worker before its run
+     */
+    void run_processes(int nr_processes, Process_Reduction& reduction) {
+        cumulative_value += reduce_over_processes<Y_AXIS>(nr_processes, reduction,
+                [this, nr_processes](int wx) { return run_worker(wx, nr_processes); });
+    }
+#endif
+
+    /**
+     * run_batched - generates the events of batch_size trials at a time into one contiguous
+     * buffer and calls trial_condition on a span of each trial's events. The first trial is the
+     * one already loaded into the distribution, so as long as trial_condition does not draw from
+     * dre itself the random values (and the result) are identical to run().
+     * @param batch_size number of trials generated per batch
+     * @param trial_condition callable as bool(std::span<X_AXIS>, Y_AXIS&, ENGINE&)
+     */
+    template <class TRIAL_CONDITION>
+    void run_batched(int batch_size, TRIAL_CONDITION trial_condition) {
+        run_batched_block(batch_size, [&](Event_Batch<X_AXIS>& batch) {
+            Y_AXIS batch_value = 0;
+            for ( int tx = 0; tx < batch.get_nr_trials(); ++tx )
+                if ( trial_condition(batch.trial(tx), interim_value, dre) )
+                    batch_value += interim_value;
+            return batch_value;
+        });
+    }
+
+    /**
+     * run_batched_block - as run_batched, but block_condition receives the whole batch and
+     * returns the amount to be added to cumulative_value for all of its trials. Afterwards the
+     * distribution holds the events of the next trial, as after run(), so that a following run
+     * continues the same stream.
+     * @param batch_size number of trials generated per batch, at least one (std::invalid_argument
+     * is thrown otherwise)
+     * @param block_condition callable as Y_AXIS(Event_Batch<X_AXIS>&)
+     */
+    template <class BLOCK_CONDITION>
+    void run_batched_block(int batch_size, BLOCK_CONDITION block_condition) {
+        if ( batch_size < 1 )
+            throw std::invalid_argument("run_batched: the batch size must be at least one trial");
+        Event_Batch<X_AXIS> batch(batch_size, distribution.get_nr_events());
+        std::copy(distribution.events.begin(), distribution.events.end(), batch.data());
+        int first_trial = 1;
+        for ( int ix = 0; ix < nr_trials; ix += batch_size ) {
+            batch.set_nr_trials(std::min(batch_size, nr_trials - ix));
+            distribution.load_batch(batch, dre, first_trial);
+            cumulative_value += block_condition(batch);
+            first_trial = 0;
+        }
+        if ( nr_trials > 0 )    ///> the loaded events were used by the first trial
+            distribution.reload_random_values(dre);
+    }
+
+    /**
+     * run_lazy - runs nr_trials trials on a Lazy_Events view of the distribution, so that only
+     * the events lazy_condition reads are drawn (a condition that returns after the first few
+     * events costs a few draws per trial instead of nr_events). The events themselves are not
+     * reloaded. The number of events drawn is available from average_events_consumed().
+     * @param lazy_condition callable as bool(Lazy_Events<Distribution, ENGINE>&, Y_AXIS&, ENGINE&)
+     */
+    template <class LAZY_CONDITION>
+    void run_lazy(LAZY_CONDITION lazy_condition) {
+        Lazy_Events<Distribution<X_AXIS, PARAM, STD_DIST, EVENTS>, ENGINE> lazy_events(distribution, dre);
+        nr_events_consumed = 0;
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            if ( lazy_condition(lazy_events, interim_value, dre) )
+                cumulative_value += interim_value;
+            nr_events_consumed += lazy_events.get_nr_drawn();
+            lazy_events.next_trial();
+        }
+    }
+
+    /**
+     * average_events_consumed - events drawn per trial by the last run_lazy.
+     */
+    double average_events_consumed() const {
+        return nr_trials > 0 ? static_cast<double>(nr_events_consumed) / static_cast<double>(nr_trials) : 0.0;
+    }
+
+    void print_events_consumed() {
+        std::cout << "events consumed per trial = " << average_events_consumed()
+                  << " of " << distribution.get_nr_events() << '\n';
+    }
+
+    /**
+     * run_with_sink - as run(), also writing the value of every trial (interim_value if the
+     * condition is met, else zero) to sink, which must have a record width of 1.
+     * @param sink binary trial file, written by its background thread
+     */
+    template <class T>
+    void run_with_sink(Trial_Sink<T>& sink) {
+        if ( sink.get_record_width() != 1 )
+            throw std::invalid_argument("run_with_sink: the sink must have a record width of 1");
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            Y_AXIS trial_value = 0;
+            if ( condition_met(distribution, interim_value, dre) )
+                trial_value = interim_value;
+            cumulative_value += trial_value;
+            sink.write(static_cast<T>(trial_value));
+            distribution.reload_random_values(dre);
+        }
+    }
+
+    /**
+     * run_with_sink - as above, each record being the trial value followed by record width - 1
+     * summaries of the trial's events (e.g., minimum, maximum, sum).
+     * @param sink binary trial file
+     * @param summarize callable as void(Distribution&, std::span<T>) filling the summaries; it is
+     * called after condition_met, i.e., it sees the events as condition_met left them
+     */
+    template <class T, class SUMMARIZE>
+    void run_with_sink(Trial_Sink<T>& sink, SUMMARIZE summarize) {
+        std::vector<T> record(sink.get_record_width());
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            Y_AXIS trial_value = 0;
+            if ( condition_met(distribution, interim_value, dre) )
+                trial_value = interim_value;
+            cumulative_value += trial_value;
+            record[0] = static_cast<T>(trial_value);
+            summarize(distribution, std::span<T>(record).subspan(1));
+            sink.write(std::span<const T>(record));
+            distribution.reload_random_values(dre);
+        }
+    }
+
+    /**
+     * run_estimators - estimates N related quantities (e.g., several probabilities of the same
+     * experiment) in one pass over the trials: every trial writes N outcomes from the same events,
+     * and their means, variances and covariances are accumulated together. cumulative_value and
+     * condition_met are not used.
+     * @param trial_outcomes callable as void(Distribution&, std::array<double, N>&, ENGINE&), the
+     * outcomes are zero on entry
+     * @return moments of the outcomes, also available from get_estimator_moments()
+     */
+    template <std::size_t N, class TRIAL_OUTCOMES>
+    const Running_Moments& run_estimators(TRIAL_OUTCOMES trial_outcomes) {
+        estimator_moments = Running_Moments(static_cast<int>(N));
+        std::array<double, N> outcomes;
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            outcomes.fill(0.0);
+            trial_outcomes(distribution, outcomes, dre);
+            estimator_moments.add(outcomes);
+            distribution.reload_random_values(dre);
+        }
+        return estimator_moments;
+    }
+
+    const Running_Moments& get_estimator_moments() const { return estimator_moments; }
+
+    /**
+     * print_estimators - mean and standard error of each outcome of run_estimators.
+     */
+    void print_estimators() {
+        for ( int ix = 0; ix < estimator_moments.size(); ++ix )
+            std::cout << "estimator " << ix << ": " << message << estimator_moments.mean(ix)
+                      << " (standard error = " << estimator_moments.standard_error(ix) << ")\n";
+    }
+
+    /**
+     * run_to_precision - runs trials until the requested precision is reached or max_trials have
+     * been run, whichever comes first. The value of a trial is interim_value if the condition is
+     * met and zero otherwise; its mean and variance are tracked online. Each call starts a fresh
+     * estimate: cumulative_value and the trial statistics are reset on entry (the results of
+     * earlier runs are dropped), and on return nr_trials holds the number of trials run by this
+     * call, so return_result(), print_result() and achieved_standard_error() apply unchanged.
+     * @param precision_target what target is compared against
+     * @param target requested standard error, relative standard error or half-width
+     * @param max_trials cap on the number of trials
+     * @param z multiple of the standard error for Confidence_Half_Width (1.96 -> 95%)
+     * @param min_trials trials run before the precision is first tested, guards against a
+     * premature stop on a too small sample (e.g., no condition met yet)
+     */
+    void run_to_precision(Precision_Target precision_target, double target, int max_trials,
+            double z = 1.96, int min_trials = 1000) {
+        double target_variance = target * target; ///> compared against the variance of the mean
+        if ( precision_target == Precision_Target::Confidence_Half_Width )
+            target_variance /= z * z;
+        cumulative_value = 0;
+        trial_statistics = Running_Statistics();
+        int ix = 0;
+        while ( ix < max_trials ) {
+            Y_AXIS trial_value = 0;
+            if ( condition_met(distribution, interim_value, dre) )
+                trial_value = interim_value;
+            cumulative_value += trial_value;
+            trial_statistics.add(static_cast<double>(trial_value));
+            distribution.reload_random_values(dre);
+            ++ix;
+            if ( ix >= min_trials ) {
+                double variance_of_mean = trial_statistics.variance() / static_cast<double>(ix);
+                double scale = precision_target == Precision_Target::Relative_Standard_Error
+                        ? trial_statistics.mean() * trial_statistics.mean() : 1.0;
+                if ( variance_of_mean <= target_variance * scale && scale > 0.0 )
+                    break;
+            }
+        }
+        nr_trials = ix;
+    }
+
+    /**
+     * run_antithetic - runs nr_trials/2 pairs of trials, the second trial of each pair on the
+     * mirrored events of the first (see Distribution::mirror_random_values). Both values of the
+     * pair are added to cumulative_value and nr_trials becomes twice the number of pairs, which
+     * amounts to accumulating the average of each pair. Note that the second trial sees the
+     * events as left by condition_met in the first (sorting them is fine, changing the values is
+     * not).
+     */
+    void run_antithetic() {
+        int nr_pairs = nr_trials / 2;
+        Running_Statistics single_statistics;
+        Running_Statistics pair_statistics;
+        for ( int ix = 0; ix < nr_pairs; ++ix ) {
+            Y_AXIS first_value = 0;
+            if ( condition_met(distribution, interim_value, dre) )
+                first_value = interim_value;
+            distribution.mirror_random_values();
+            Y_AXIS second_value = 0;
+            if ( condition_met(distribution, interim_value, dre) )
+                second_value = interim_value;
+            cumulative_value += first_value + second_value;
+            single_statistics.add(static_cast<double>(first_value));
+            single_statistics.add(static_cast<double>(second_value));
+            pair_statistics.add(0.5 * (static_cast<double>(first_value) + static_cast<double>(second_value)));
+            distribution.reload_random_values(dre);
+        }
+        nr_trials = 2 * nr_pairs;
+        // Independent trials would give the mean of a pair a variance of var(single)/2.
+        variance_reduction = pair_statistics.variance() > 0.0
+                ? single_statistics.variance() / (2.0 * pair_statistics.variance()) : 1.0;
+    }
+
+    /**
+     * variance_reduction_factor - ratio of the variance of independent sampling to that of the
+     * antithetic pairs, as observed in the last run_antithetic (greater than one is a gain).
+     */
+    double variance_reduction_factor() const { return variance_reduction; }
+
+    /**
+     * print_variance_reduction - prints the observed variance reduction factor of run_antithetic.
+     */
+    void print_variance_reduction() {
+        std::cout << "variance reduction factor = " << variance_reduction << '\n';
+    }
+
+    /**
+     * add_control_variate - registers a quantity computed from the events of each trial whose
+     * expectation is known exactly (e.g., the sum of nr_events uniform events on [0,1) has
+     * expectation nr_events/2). It is used by run_with_control_variates.
+     * @param control function of the distribution's events
+     * @param known_mean exact expectation of control
+     */
+    void add_control_variate(std::function<double(Distribution<X_AXIS, PARAM, STD_DIST, EVENTS>&)> control,
+            double known_mean) {
+        controls.push_back(std::move(control));
+        control_means.push_back(known_mean);
+    }
+
+    /**
+     * run_with_control_variates - as run(), but also evaluates each control on the events of
+     * the trial (before condition_met, which may rearrange them) and accumulates the means and
+     * covariances of the trial value and the controls online. The plain estimate is still
+     * available through return_result(); the adjusted one through return_controlled_result().
+     */
+    void run_with_control_variates() {
+        int nr_controls = static_cast<int>(controls.size());
+        control_moments = Running_Moments(nr_controls + 1);
+        std::vector<double> values(nr_controls + 1);
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            for ( int cx = 0; cx < nr_controls; ++cx )
+                values[cx + 1] = controls[cx](distribution);
+            Y_AXIS trial_value = 0;
+            if ( condition_met(distribution, interim_value, dre) )
+                trial_value = interim_value;
+            cumulative_value += trial_value;
+            values[0] = static_cast<double>(trial_value);
+            control_moments.add(values);
+            distribution.reload_random_values(dre);
+        }
+    }
+
+    /**
+     * control_coefficients - the estimated optimal coefficient of each control, i.e., the
+     * regression coefficients of the trial value on the controls.
+     */
+    std::vector<double> control_coefficients() const {
+        return regression_coefficients(control_moments);
+    }
+
+    /**
+     * return_controlled_result - the control variate estimator:
+     * mean(y) - sum_j beta_j * (mean(c_j) - known_mean_j)
+     */
+    double return_controlled_result() const {
+        std::vector<double> beta = control_coefficients();
+        double result = control_moments.mean(0);
+        for ( int cx = 0; cx < static_cast<int>(beta.size()); ++cx )
+            result -= beta[cx] * (control_moments.mean(cx + 1) - control_means[cx]);
+        return result;
+    }
+
+    /**
+     * return_controlled_variance - estimated variance of return_controlled_result(), i.e., the
+     * residual variance of the trial value after regression on the controls, divided by the
+     * number of trials.
+     */
+    double return_controlled_variance() const {
+        std::vector<double> beta = control_coefficients();
+        double residual = control_moments.variance(0);
+        for ( int cx = 0; cx < static_cast<int>(beta.size()); ++cx )
+            residual -= beta[cx] * control_moments.covariance(cx + 1, 0);
+        long long n = control_moments.count();
+        return n > 0 && residual > 0.0 ? residual / static_cast<double>(n) : 0.0;
+    }
+
+    /**
+     * print_controlled_result - prints the adjusted estimate and its standard error along with
+     * the standard error of the plain estimate.
+     */
+    void print_controlled_result() {
+        std::cout << message << return_controlled_result()
+                  << " (standard error = " << std::sqrt(return_controlled_variance())
+                  << ", without controls = " << control_moments.standard_error(0) << ")\n";
+    }
+
+    /**
+     * trials_used - number of trials run by run_to_precision (same as nr_trials afterwards).
+     */
+    int trials_used() const { return nr_trials; }
+
+    /**
+     * achieved_standard_error - standard error of return_result() after run_to_precision.
+     */
+    double achieved_standard_error() const { return trial_statistics.standard_error(); }
+
+    /**
+     * print_precision - prints the trials used and the achieved standard error, to go along
+     * with print_result().
+     */
+    void print_precision() {
+        std::cout << "trials used = " << trials_used()
+                  << ", standard error = " << achieved_standard_error() << '\n';
     }
 
     virtual void change_message(const std::string& s) {
@@ -106,18 +732,25 @@ public:
  * @tparam Y_AXIS - For the y-axis or range of the distribution, expected to be either integral or floating point.
  * @tparam PARAM - Input parameter type, e.g, for Poisson it is of real type even though values T are integral
  * @tparam STD_DIST - A template template of the Distribution - when object created, e.g., std::uniform_int_distribution
+ * @tparam EVENTS - Container of the distribution's events, std::deque or Contiguous_Events
+ * @tparam ENGINE - Random engine (UniformRandomBitGenerator), e.g., std::mt19937_64, PCG64, Xoshiro256StarStar
+ * @tparam CONDITION - Type of condition_met; defaults to std::function, a lambda type lets run_trials inline it
  */
 
-template <class X_AXIS, class Y_AXIS, class PARAM, class STD_DIST>
+template <class X_AXIS, class Y_AXIS, class PARAM, class STD_DIST,
+        class EVENTS = std::deque<X_AXIS>, class ENGINE = DRE,
+        class CONDITION = std::function<bool(Distribution_NTT<X_AXIS, PARAM, STD_DIST, EVENTS>&, Y_AXIS&, ENGINE&)>>
 class MonteCarloSimulation_NTT {
 protected:
     int nr_trials; ///> number of repeated trials run for the simulation
-    DRE dre;			///> default random engine
+    int seed;       ///> seed of dre, also the root of the per-worker streams in run_parallel
+    ENGINE dre;			///> random engine, std::default_random_engine unless ENGINE is given
     Y_AXIS cumulative_value; ///> accumulates the interim value for nr_trials
     Y_AXIS interim_value;		///> value determined for each trial
     std::string message; ///> message can be changed to match the meaning of cumulative_value/nr_trials
-    Distribution_NTT<X_AXIS, PARAM, STD_DIST> distribution; ///> (e.g., real) and deque of numbers selected from it
-    std::function<bool(Distribution_NTT<X_AXIS, PARAM, STD_DIST>&, Y_AXIS&, DRE&)> condition_met; ///> function containing particulars of the simulation
+    Distribution_NTT<X_AXIS, PARAM, STD_DIST, EVENTS> distribution; ///> (e.g., real) and deque of numbers selected from it
+    CONDITION condition_met; ///> function containing particulars of the simulation
+    Instrumentation_Stats instrumentation; ///> filled by run_trials if MONTECARLO_INSTRUMENT is defined
 
 public:
 
@@ -131,13 +764,13 @@ public:
      * @param _distribution (e.g., real) and deque of numbers selected from it
      */
     MonteCarloSimulation_NTT ( int _nr_trials, int _seed,
-                           std::function<bool(Distribution_NTT<X_AXIS, PARAM, STD_DIST>&, Y_AXIS&, DRE&)> _condition_met,
-                           Distribution_NTT<X_AXIS, PARAM, STD_DIST>& _distribution )
-            : nr_trials(_nr_trials), dre(_seed),
+                           CONDITION _condition_met,
+                           Distribution_NTT<X_AXIS, PARAM, STD_DIST, EVENTS>& _distribution )
+            : nr_trials(_nr_trials), seed(_seed), dre(_seed),
               cumulative_value(0), interim_value(1),
               message("probability is = "),
-              condition_met(_condition_met),
-              distribution(std::move(_distribution))
+              distribution(std::move(_distribution)),
+              condition_met(_condition_met)
     {
         distribution.load_random_values(dre);
     }
@@ -147,13 +780,173 @@ public:
      * functions were changed to accept dre from here.
      */
     virtual void run() {
+        run_trials();
+    }
+
+    /**
+     * run_trials - non-virtual body of run(), so that a call on the concrete type (together
+     * with a lambda CONDITION) lets the whole trial be inlined.
+     */
+    void run_trials() {
+#ifdef MONTECARLO_INSTRUMENT
+        Instrumented_Run instrumented_run(instrumentation, nr_trials);
+        Counting_Engine<ENGINE> counting_dre(dre);
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            std::uint64_t t0 = cycle_counter();
+            bool met = condition_met(distribution, interim_value, dre);
+            std::uint64_t t1 = cycle_counter();
+            if ( met )
+                cumulative_value += interim_value;
+            std::uint64_t t2 = cycle_counter();
+            distribution.reload_random_values(counting_dre);
+            std::uint64_t t3 = cycle_counter();
+            instrumentation.condition_cycles += t1 - t0;
+            instrumentation.accumulate_cycles += t2 - t1;
+            instrumentation.rng_cycles += t3 - t2;
+        }
+        instrumentation.rng_draws = counting_dre.get_nr_draws();
+#else
         for ( int ix = 0; ix < nr_trials; ++ix ) {
             if ( condition_met(distribution, interim_value, dre) )
                 cumulative_value += interim_value;
             distribution.reload_random_values(dre);
         }
+#endif
+    }
+
+    /**
+     * get_instrumentation - phase timings of the last run_trials, all zero unless
+     * MONTECARLO_INSTRUMENT is defined (see Instrumentation.h).
+     */
+    const Instrumentation_Stats& get_instrumentation() const { return instrumentation; }
+
+    /**
+     * run_async - runs the trials of run_trials() on a background thread and returns at once.
+     * The handle reports the trials done, the estimate and the throughput, and can cancel the
+     * run, after which nr_trials holds the trials done and return_result() the partial result.
+     * Run to the end, the result is the same as that of run_trials(). The simulation must
+     * outlive the handle and must not be used otherwise until the run has finished.
+     * @param callback called on the run thread with the progress every interval, and once at the end
+     * @param interval minimum time between two calls of callback
+     * @param chunk_trials trials between two updates of the progress, at least one
+     */
+    Async_Run run_async(Progress_Callback callback = {},
+            std::chrono::milliseconds interval = std::chrono::milliseconds(1000), int chunk_trials = 4096) {
+        return launch_async_run(static_cast<std::uint64_t>(nr_trials), chunk_trials, interval, std::move(callback),
+                [this](int count) {
+                    for ( int ix = 0; ix < count; ++ix ) {
+                        if ( condition_met(distribution, interim_value, dre) )
+                            cumulative_value += interim_value;
+                        distribution.reload_random_values(dre);
+                    }
+                    return static_cast<double>(cumulative_value);
+                },
+                [this](std::uint64_t nr_trials_done) { nr_trials = static_cast<int>(nr_trials_done); });
+    }
+
+    /**
+     * run_parallel - splits the nr_trials over nr_threads workers. Each worker runs on its own
+     * copy of the distribution and of condition_met, with its own engine seeded from
+     * (seed, worker index) through std::seed_seq so that the streams are independent. The
+     * worker sums are added to cumulative_value in worker order once all of them are joined,
+     * so the result is reproducible for a given seed and number of threads (it is not the
+     * same as the result of the single-threaded run()).
+     * Note that condition_met must not share mutable state between the copies (e.g., through
+     * a reference capture), since the copies are called concurrently; a histogram is filled
+     * through Histogram_Shards (see the overload below).
+     * @param nr_threads number of worker threads, at least one (std::invalid_argument is thrown
+     * otherwise)
+     */
+    virtual void run_parallel(int nr_threads) {
+        if ( nr_threads < 1 )
+            throw std::invalid_argument("run_parallel: at least one thread is needed");
+        std::vector<Y_AXIS> worker_values(nr_threads, Y_AXIS(0));
+        std::vector<std::exception_ptr> worker_errors(nr_threads);
+        std::vector<std::thread> workers;
+        for ( int wx = 0; wx < nr_threads; ++wx )
+            workers.emplace_back([this, wx, nr_threads, &worker_values, &worker_errors]() {
+                try {
+                    worker_values[wx] = run_worker(wx, nr_threads);
+                }
+                catch (...) {
+                    worker_errors[wx] = std::current_exception();
+                }
+            });
+        for ( std::thread& worker : workers )
+            worker.join();
+        for ( std::exception_ptr& error : worker_errors )
+            if ( error ) std::rethrow_exception(error);
+        for ( Y_AXIS value : worker_values )
+            cumulative_value += value;
+    }
+
+    /**
+     * run_parallel - as above, with condition_met filling shards.local(); the shards are merged
+     * into their histogram once the workers are joined.
+     * @param nr_threads number of worker threads, at most shards.get_nr_shards()
+     * @param shards per-worker amounts of the histogram filled by condition_met
+     */
+    template <class T, class U>
+    void run_parallel(int nr_threads, Histogram_Shards<T,U>& shards) {
+        if ( nr_threads > shards.get_nr_shards() )
+            throw std::invalid_argument("run_parallel: fewer histogram shards than threads");
+        run_parallel(nr_threads);
+        shards.merge();
+    }
+
+    /**
+     * run_worker - runs the share of nr_trials belonging to worker (the first
+     * nr_trials % nr_workers workers take one extra trial).
+     * @param worker index of the worker, also selects its random number stream
+     * @param nr_workers total number of workers
+     * @return accumulated interim values of this worker
+     */
+    Y_AXIS run_worker(int worker, int nr_workers) const {
+        int worker_trials = nr_trials / nr_workers + (worker < nr_trials % nr_workers ? 1 : 0);
+        Histogram_Shard_Scope shard_scope(worker);
+        std::seed_seq worker_seeds{seed, worker};
+        ENGINE worker_dre(worker_seeds);
+        auto worker_distribution = distribution;
+        auto worker_condition = condition_met;
+        Y_AXIS worker_interim = interim_value;
+        Y_AXIS worker_cumulative = 0;
+        worker_distribution.reload_random_values(worker_dre);
+        for ( int ix = 0; ix < worker_trials; ++ix ) {
+            if ( worker_condition(worker_distribution, worker_interim, worker_dre) )
+                worker_cumulative += worker_interim;
+            worker_distribution.reload_random_values(worker_dre);
+        }
+        return worker_cumulative;
+    }
+
+#if defined(MONTECARLO_MULTI_PROCESS) && defined(MONTECARLO_HAS_FORK)
+    /**
+     * run_processes - like run_parallel, but each worker runs in a forked process and the worker
+     * sums are reduced through shared memory (see Multi_Process.h). The workers are the same as
+     * those of run_parallel, so the result equals run_parallel(nr_processes) for the same seed.
+     * Note that this is not the result of run() for that seed: each worker draws from its own
+     * stream, seeded from (seed, worker index), since the serial stream cannot be split into
+     * trial ranges when condition_met may draw from dre itself. Only compiled with
+     * MONTECARLO_MULTI_PROCESS defined.
+     * @param nr_processes number of worker processes
+     */
+    void run_processes(int nr_processes) {
+        Process_Reduction no_reduction;
+        run_processes(nr_processes, no_reduction);
     }
 
+    /**
+     * run_processes - as above, and also adds up the objects attached to reduction (e.g., a
+     * histogram filled by condition_met) over the workers into the launching process' objects.
+     * @param nr_processes number of worker processes
+     * @param reduction objects filled by condition_met, cleared in each worker before its run
+     */
+    void run_processes(int nr_processes, Process_Reduction& reduction) {
+        cumulative_value += reduce_over_processes<Y_AXIS>(nr_processes, reduction,
+                [this, nr_processes](int wx) { return run_worker(wx, nr_processes); });
+    }
+#endif
+
     virtual void change_message(const std::string& s) {
         message = s;
     }
@@ -179,4 +972,33 @@ public:
     }
 };
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * make_monte_carlo_simulation - builds a MonteCarloSimulation whose CONDITION is the type of
+ * the callable passed in (typically a lambda) rather than std::function. Only Y_AXIS has to
+ * be given, e.g., auto mcs = make_monte_carlo_simulation<int>(nr_trials, seed, lambda, distribution);
+ * ENGINE may follow it, e.g., make_monte_carlo_simulation<int, PCG64>(...).
+ */
+template <class Y_AXIS, class ENGINE = DRE, class X_AXIS, class PARAM, template <class> class STD_DIST,
+        class EVENTS, class CONDITION>
+MonteCarloSimulation<X_AXIS, Y_AXIS, PARAM, STD_DIST, EVENTS, ENGINE, CONDITION>
+make_monte_carlo_simulation(int nr_trials, int seed, CONDITION condition_met,
+        Distribution<X_AXIS, PARAM, STD_DIST, EVENTS>& distribution) {
+    return MonteCarloSimulation<X_AXIS, Y_AXIS, PARAM, STD_DIST, EVENTS, ENGINE, CONDITION>(
+            nr_trials, seed, std::move(condition_met), distribution);
+}
+
+/**
+ * make_monte_carlo_simulation - same as above for Distribution_NTT.
+ */
+template <class Y_AXIS, class ENGINE = DRE, class X_AXIS, class PARAM, class STD_DIST, class EVENTS, class CONDITION>
+MonteCarloSimulation_NTT<X_AXIS, Y_AXIS, PARAM, STD_DIST, EVENTS, ENGINE, CONDITION>
+make_monte_carlo_simulation(int nr_trials, int seed, CONDITION condition_met,
+        Distribution_NTT<X_AXIS, PARAM, STD_DIST, EVENTS>& distribution) {
+    return MonteCarloSimulation_NTT<X_AXIS, Y_AXIS, PARAM, STD_DIST, EVENTS, ENGINE, CONDITION>(
+            nr_trials, seed, std::move(condition_met), distribution);
+}
+
 #endif //MONTECARLO_MONTECARLOSIM_BETA_H
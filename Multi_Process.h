@@ -0,0 +1,221 @@
+/**
+ * \file Multi_Process.h
+ * \date 17-Oct-2026
+ *
+ * \brief Runs the workers of a simulation in forked processes and reduces their results
+ * (cumulative values and attached histograms) through a shared memory segment.
+ *
+ * \details Each worker process gets a cache-line aligned slot of a MAP_SHARED anonymous mapping
+ * created before the fork, writes its accumulated value and the amounts of the attached
+ * histograms into it and exits; the launching process waits for all of them and adds the slots
+ * up in worker order. A worker runs the same trials with the same stream as the thread of the
+ * same index in run_parallel, so run_processes(n) gives the same result as run_parallel(n).
+ * This deliberately differs from the result of the single-process run() for the same seed:
+ * the serial stream cannot be split into trial ranges in general (the number of draws per trial
+ * is not known when condition_met draws from dre), so the workers use independent streams.
+ * Unlike threads, the processes do not share the histograms filled by condition_met, so a
+ * condition capturing a histogram by reference is safe here (each process fills its own copy,
+ * which is cleared in the child before the run).
+ * Fork copies only the calling thread, so this should be launched from a program that has no
+ * other threads running. POSIX only; MONTECARLO_HAS_FORK tells whether it is available.
+ * MonteCarloSim_beta.h includes this header, and defines run_processes, only when
+ * MONTECARLO_MULTI_PROCESS is defined (e.g., -DMONTECARLO_MULTI_PROCESS), so that the POSIX
+ * headers do not reach every user of the simulations.
+ * Errors (segment, fork, a worker that fails or dies) are reported as std::runtime_error; each
+ * worker writes a status word to its slot, so that the error tells which one and how.
+ */
+
+#ifndef MONTECARLO_MULTI_PROCESS_H
+#define MONTECARLO_MULTI_PROCESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <val/montecarlo/Histogram.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MONTECARLO_HAS_FORK 1
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Process_Reduction - objects filled during a run that are added up over the worker processes.
+ */
+class Process_Reduction {
+    struct Attached {
+        std::size_t nr_bytes;
+        std::function<void()> clear;
+        std::function<void(unsigned char*)> export_to;
+        std::function<void(const unsigned char*)> add_from;
+    };
+    std::vector<Attached> attached;
+
+    static std::size_t aligned(std::size_t nr_bytes) { return (nr_bytes + 15) / 16 * 16; }
+
+public:
+
+    /**
+     * attach - includes a histogram (typically captured by condition_met) in the reduction.
+     * @param histogram must outlive the run
+     */
+    template <class T, class U>
+    void attach(Histogram<T,U>& histogram) {
+        static_assert(std::is_trivially_copyable_v<U>, "histogram amounts must be trivially copyable");
+        attached.push_back(Attached{
+                histogram.raw_size() * sizeof(U),
+                [&histogram]() { histogram.clear_amounts(); },
+                [&histogram](unsigned char* out) {
+                    std::vector<U> amounts(histogram.raw_size());
+                    histogram.export_amounts(amounts.data());
+                    std::memcpy(out, amounts.data(), amounts.size() * sizeof(U));
+                },
+                [&histogram](const unsigned char* in) {
+                    std::vector<U> amounts(histogram.raw_size());
+                    std::memcpy(amounts.data(), in, amounts.size() * sizeof(U));
+                    histogram.add_amounts(amounts.data());
+                }});
+    }
+
+    /**
+     * size_bytes - bytes of shared memory one worker needs for the attached objects.
+     */
+    std::size_t size_bytes() const {
+        std::size_t total = 0;
+        for ( const Attached& a : attached )
+            total += aligned(a.nr_bytes);
+        return total;
+    }
+
+    void clear() {
+        for ( Attached& a : attached )
+            a.clear();
+    }
+
+    void export_to(unsigned char* out) const {
+        for ( const Attached& a : attached ) {
+            a.export_to(out);
+            out += aligned(a.nr_bytes);
+        }
+    }
+
+    void add_from(const unsigned char* in) {
+        for ( Attached& a : attached ) {
+            a.add_from(in);
+            in += aligned(a.nr_bytes);
+        }
+    }
+};
+
+#ifdef MONTECARLO_HAS_FORK
+
+/**
+ * Shared_Segment - anonymous shared mapping, inherited by forked children.
+ */
+class Shared_Segment {
+    void* base;
+    std::size_t nr_bytes;
+public:
+    explicit Shared_Segment(std::size_t _nr_bytes) : nr_bytes(_nr_bytes) {
+        base = mmap(nullptr, nr_bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if ( base == MAP_FAILED )
+            throw std::runtime_error("Shared_Segment: cannot map shared memory");
+        std::memset(base, 0, nr_bytes);
+    }
+
+    ~Shared_Segment() { munmap(base, nr_bytes); }
+
+    Shared_Segment(const Shared_Segment&) = delete;
+    Shared_Segment& operator=(const Shared_Segment&) = delete;
+
+    unsigned char* data() { return static_cast<unsigned char*>(base); }
+};
+
+/**
+ * reduce_over_processes - forks nr_processes workers, runs worker(index) in each and returns the
+ * sum of their values in worker order; the attached objects of reduction are added up likewise.
+ * @param nr_processes number of worker processes
+ * @param reduction objects filled during the run, cleared in each child before worker runs
+ * @param worker callable as Y_AXIS(int worker_index)
+ */
+template <class Y_AXIS, class WORKER>
+Y_AXIS reduce_over_processes(int nr_processes, Process_Reduction& reduction, WORKER worker) {
+    static_assert(std::is_trivially_copyable_v<Y_AXIS>, "Y_AXIS must be trivially copyable");
+    if ( nr_processes < 1 )
+        throw std::invalid_argument("reduce_over_processes: at least one worker process is needed");
+    constexpr std::size_t header_bytes = 64;    ///> status word, on its own cache line
+    constexpr std::uint32_t status_done = 1, status_failed = 2;  ///> 0: the worker died first
+    std::size_t value_bytes = (sizeof(Y_AXIS) + 63) / 64 * 64;
+    std::size_t slot_bytes = header_bytes + value_bytes + (reduction.size_bytes() + 63) / 64 * 64;
+    Shared_Segment segment(slot_bytes * static_cast<std::size_t>(nr_processes));
+
+    std::cout.flush();  ///> buffered output would otherwise be written again by every child
+    std::fflush(nullptr);
+    std::vector<pid_t> children;
+    for ( int wx = 0; wx < nr_processes; ++wx ) {
+        pid_t pid = fork();
+        if ( pid < 0 ) {
+            for ( pid_t child : children )
+                waitpid(child, nullptr, 0);
+            throw std::runtime_error("reduce_over_processes: fork failed");
+        }
+        if ( pid == 0 ) {
+            unsigned char* slot = segment.data() + slot_bytes * wx;
+            std::uint32_t status = status_failed;
+            try {
+                reduction.clear();
+                Y_AXIS value = worker(wx);
+                std::memcpy(slot + header_bytes, &value, sizeof(Y_AXIS));
+                reduction.export_to(slot + header_bytes + value_bytes);
+                status = status_done;
+            }
+            catch (...) {
+            }
+            std::memcpy(slot, &status, sizeof(status));
+            std::fflush(nullptr);
+            _exit(status == status_done ? 0 : 1);
+        }
+        children.push_back(pid);
+    }
+
+    bool all_exited = true;
+    for ( pid_t child : children ) {
+        int exit_status = 0;
+        if ( waitpid(child, &exit_status, 0) != child || !WIFEXITED(exit_status) || WEXITSTATUS(exit_status) != 0 )
+            all_exited = false;
+    }
+    // The status word tells a worker that threw from one that died (e.g., killed by a signal)
+    // and guards against a child that exited normally without writing its results.
+    for ( int wx = 0; wx < nr_processes; ++wx ) {
+        std::uint32_t status = 0;
+        std::memcpy(&status, segment.data() + slot_bytes * wx, sizeof(status));
+        if ( status == status_failed )
+            throw std::runtime_error("reduce_over_processes: worker " + std::to_string(wx) + " threw an exception");
+        if ( status != status_done )
+            throw std::runtime_error("reduce_over_processes: worker " + std::to_string(wx) + " died before finishing");
+    }
+    if ( !all_exited )
+        throw std::runtime_error("reduce_over_processes: a worker process failed");
+
+    Y_AXIS total = 0;
+    for ( int wx = 0; wx < nr_processes; ++wx ) {
+        const unsigned char* slot = segment.data() + slot_bytes * wx;
+        Y_AXIS value;
+        std::memcpy(&value, slot + header_bytes, sizeof(Y_AXIS));
+        total += value;
+        reduction.add_from(slot + header_bytes + value_bytes);
+    }
+    return total;
+}
+
+#endif // MONTECARLO_HAS_FORK
+
+#endif //MONTECARLO_MULTI_PROCESS_H
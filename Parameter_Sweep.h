@@ -0,0 +1,176 @@
+/**
+ * \file Parameter_Sweep.h
+ * \date 17-Oct-2026
+ *
+ * \brief Parameter_Sweep class, runs the same kind of simulation over a grid of parameter
+ * points (bounds, nr_events, Poisson means, ...) on a pool of worker threads and collects
+ * one row of results per point.
+ *
+ * \details The factory turns a point of the grid into a (Distribution_NTT, condition) pair,
+ * which is then run for nr_trials trials exactly as MonteCarloSimulation_NTT::run_trials
+ * would. Points are handed out to the workers one at a time, so points of very different
+ * cost balance themselves. Each worker keeps the events container of its previous point and
+ * swaps it into the next distribution, i.e., with Contiguous_Events the event storage is
+ * allocated once per worker rather than once per point (fixed-size std::array events live in
+ * the distribution and are not recycled). The engine of point i is seeded from (seed, i)
+ * through std::seed_seq, so the results depend on the grid and the seed but not on the
+ * number of threads or the order in which the points were run.
+ * The factory is called concurrently by the workers and must not modify shared state.
+ */
+
+#ifndef MONTECARLO_PARAMETER_SWEEP_H
+#define MONTECARLO_PARAMETER_SWEEP_H
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <val/montecarlo/Distribution_beta.h>
+
+/**
+ * Sweep_Result - one row of the result table of a Parameter_Sweep.
+ */
+template <class POINT>
+struct Sweep_Result {
+    std::size_t index;  ///> position of the point in the grid
+    POINT point;
+    int nr_trials;      ///> number of trials run for the point
+    double result;      ///> cumulative value / nr_trials, as MonteCarloSimulation::return_result
+    double seconds;     ///> wall time of the point, including the factory call
+};
+
+/**
+ * Parameter_Sweep
+ * @tparam Y_AXIS - For the y-axis or range of the distribution, expected to be either integral or floating point.
+ * @tparam POINT - One point of the parameter grid, any copyable type (e.g., a struct or std::tuple)
+ * @tparam FACTORY - Callable as std::pair<DISTRIBUTION, CONDITION>(const POINT&), where CONDITION
+ * is callable as bool(DISTRIBUTION&, Y_AXIS&, ENGINE&)
+ * @tparam ENGINE - Random engine (UniformRandomBitGenerator)
+ */
+template <class Y_AXIS, class POINT, class FACTORY, class ENGINE = std::default_random_engine>
+class Parameter_Sweep {
+    using CASE = std::invoke_result_t<FACTORY&, const POINT&>;
+    using DISTRIBUTION = typename CASE::first_type;
+    using EVENTS = decltype(DISTRIBUTION::events);
+
+    std::vector<POINT> grid;
+    FACTORY factory;
+    int nr_trials;  ///> trials run for each point
+    int seed;       ///> root of the per-point engine seeds
+    std::vector<Sweep_Result<POINT>> results; ///> in grid order
+
+    /**
+     * run_point - runs one point, spare is the events container recycled from the worker's previous point.
+     */
+    Sweep_Result<POINT> run_point(std::size_t index, EVENTS& spare) const {
+        auto start = std::chrono::steady_clock::now();
+        CASE sweep_case = factory(grid[index]);
+        DISTRIBUTION& distribution = sweep_case.first;
+        auto& condition_met = sweep_case.second;
+
+        if constexpr ( !Fixed_Events<EVENTS>::value ) {  ///> a std::array has nothing to recycle
+            spare.clear();
+            std::swap(distribution.events, spare);
+        }
+        std::seed_seq point_seeds{seed, static_cast<int>(index)};
+        ENGINE dre(point_seeds);
+        Y_AXIS interim_value = 1;
+        Y_AXIS cumulative_value = 0;
+
+        distribution.load_random_values(dre);
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            if ( condition_met(distribution, interim_value, dre) )
+                cumulative_value += interim_value;
+            distribution.reload_random_values(dre);
+        }
+        if constexpr ( !Fixed_Events<EVENTS>::value )
+            std::swap(distribution.events, spare);
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        return Sweep_Result<POINT>{index, grid[index], nr_trials,
+                                   static_cast<double>(cumulative_value) / static_cast<double>(nr_trials),
+                                   elapsed.count()};
+    }
+
+public:
+
+    /**
+     * Parameter_Sweep constructor
+     * @param _grid parameter points, one result row per point
+     * @param _factory builds the distribution and condition of a point
+     * @param _nr_trials number of trials per point
+     * @param _seed root of the per-point engine seeds
+     */
+    Parameter_Sweep(std::vector<POINT> _grid, FACTORY _factory, int _nr_trials, int _seed)
+            : grid(std::move(_grid)), factory(std::move(_factory)),
+              nr_trials(_nr_trials), seed(_seed) {}
+
+    /**
+     * run - runs all points on nr_threads workers, replacing the results of an earlier run.
+     * An exception thrown for a point stops its worker and is rethrown once all workers are joined.
+     * @param nr_threads number of worker threads
+     */
+    void run(int nr_threads = static_cast<int>(std::thread::hardware_concurrency())) {
+        if ( nr_threads < 1 ) nr_threads = 1;
+        std::vector<std::optional<Sweep_Result<POINT>>> rows(grid.size());
+        std::atomic<std::size_t> next_point{0};
+        std::vector<std::exception_ptr> worker_errors(nr_threads);
+        std::vector<std::thread> workers;
+        for ( int wx = 0; wx < nr_threads; ++wx )
+            workers.emplace_back([this, wx, &rows, &next_point, &worker_errors]() {
+                try {
+                    EVENTS spare;
+                    for ( std::size_t px = next_point++; px < grid.size(); px = next_point++ )
+                        rows[px] = run_point(px, spare);
+                }
+                catch (...) {
+                    worker_errors[wx] = std::current_exception();
+                }
+            });
+        for ( std::thread& worker : workers )
+            worker.join();
+        for ( std::exception_ptr& error : worker_errors )
+            if ( error ) std::rethrow_exception(error);
+        results.clear();
+        for ( std::optional<Sweep_Result<POINT>>& row : rows )
+            results.push_back(std::move(*row));
+    }
+
+    const std::vector<Sweep_Result<POINT>>& get_results() const { return results; }
+
+    /**
+     * print_results - the result table, one line per point; the point itself is printed when it
+     * has a stream output operator.
+     */
+    void print_results(std::ostream& o = std::cout) const {
+        o << std::setw(8) << "index" << std::setw(12) << "trials" << std::setw(16) << "result"
+          << std::setw(12) << "seconds" << "  point\n";
+        for ( const Sweep_Result<POINT>& row : results ) {
+            o << std::setw(8) << row.index << std::setw(12) << row.nr_trials << std::setw(16) << row.result
+              << std::setw(12) << row.seconds << "  ";
+            if constexpr ( requires { o << row.point; } )
+                o << row.point;
+            o << '\n';
+        }
+    }
+};
+
+/**
+ * make_parameter_sweep - builds a Parameter_Sweep with POINT and FACTORY deduced; Y_AXIS (and
+ * optionally ENGINE) have to be given, e.g., auto sweep = make_parameter_sweep<int>(grid, factory, nr_trials, seed);
+ */
+template <class Y_AXIS, class ENGINE = std::default_random_engine, class POINT, class FACTORY>
+Parameter_Sweep<Y_AXIS, POINT, FACTORY, ENGINE>
+make_parameter_sweep(std::vector<POINT> grid, FACTORY factory, int nr_trials, int seed) {
+    return Parameter_Sweep<Y_AXIS, POINT, FACTORY, ENGINE>(std::move(grid), std::move(factory), nr_trials, seed);
+}
+
+#endif //MONTECARLO_PARAMETER_SWEEP_H
@@ -0,0 +1,403 @@
+/**
+ * \file Random_Engines.h
+ * \date 17-Oct-2026
+ *
+ * \brief Random number engines, in addition to those of <random>, satisfying
+ * UniformRandomBitGenerator so that they can be passed to every Distribution and State.
+ *
+ * \details Philox4x32 is the counter-based generator of Salmon et al. (Random123):
+ * the output is a keyed bijection (10 rounds) of a 128-bit counter, so a stream is
+ * identified by (seed, stream) and any position in it is reached in O(1), e.g., the
+ * stream of trial N is Philox4x32(seed, N) whatever trials were run before it, and
+ * workers can split the trials with no overlap between their streams.
+ * Xoshiro256StarStar is the 64-bit generator of Blackman and Vigna, fast and of much
+ * better quality than std::default_random_engine; jump() advances it by 2^128 values,
+ * which gives non-overlapping streams (e.g., the lanes of Bulk_Uniform_Generator).
+ * PCG64 is O'Neill's permuted congruential generator (128-bit LCG, XSL-RR output, same
+ * values as pcg64 of pcg-cpp), with 2^127 selectable streams and O(log n) discard.
+ */
+
+#ifndef MONTECARLO_RANDOM_ENGINES_H
+#define MONTECARLO_RANDOM_ENGINES_H
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <type_traits>
+
+class Philox4x32 {
+public:
+    using result_type = std::uint32_t;
+
+private:
+    static constexpr std::uint32_t multiplier_0 = 0xD2511F53;
+    static constexpr std::uint32_t multiplier_1 = 0xCD9E8D57;
+    static constexpr std::uint32_t weyl_0 = 0x9E3779B9;
+    static constexpr std::uint32_t weyl_1 = 0xBB67AE85;
+
+    std::array<std::uint32_t, 2> key;     ///> from the seed
+    std::array<std::uint32_t, 4> counter; ///> block index (words 0, 1) and stream (words 2, 3)
+    std::array<std::uint32_t, 4> output;  ///> current block of output
+    int position;                         ///> next word of output to return, 4 if used up
+
+    static void multiply(std::uint32_t a, std::uint32_t b, std::uint32_t& hi, std::uint32_t& lo) {
+        std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+        hi = static_cast<std::uint32_t>(product >> 32);
+        lo = static_cast<std::uint32_t>(product);
+    }
+
+    void generate_block() {
+        std::array<std::uint32_t, 4> x = counter;
+        std::uint32_t k0 = key[0], k1 = key[1];
+        for ( int rx = 0; rx < 10; ++rx ) {
+            std::uint32_t hi0, lo0, hi1, lo1;
+            multiply(multiplier_0, x[0], hi0, lo0);
+            multiply(multiplier_1, x[2], hi1, lo1);
+            x = {hi1 ^ x[1] ^ k0, lo1, hi0 ^ x[3] ^ k1, lo0};
+            k0 += weyl_0;
+            k1 += weyl_1;
+        }
+        output = x;
+    }
+
+    void increment_block() {
+        if ( ++counter[0] == 0 )
+            ++counter[1];
+    }
+
+public:
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    /**
+     * Philox4x32 constructor
+     * @param _seed key of the generator
+     * @param _stream selects one of 2^64 streams (e.g., trial or worker index), each 2^66 values long
+     */
+    explicit Philox4x32(std::uint64_t _seed = 0, std::uint64_t _stream = 0)
+            : key{static_cast<std::uint32_t>(_seed), static_cast<std::uint32_t>(_seed >> 32)} {
+        set_stream(_stream);
+    }
+
+    /**
+     * Philox4x32 constructor from a seed sequence (std::seed_seq), same as for the std engines.
+     */
+    template <class SEED_SEQ>
+        requires (!std::is_integral_v<SEED_SEQ>)
+    explicit Philox4x32(SEED_SEQ& seed_sequence) {
+        std::array<std::uint32_t, 2> words;
+        seed_sequence.generate(words.begin(), words.end());
+        key = words;
+        set_stream(0);
+    }
+
+    void seed(std::uint64_t _seed) {
+        key = {static_cast<std::uint32_t>(_seed), static_cast<std::uint32_t>(_seed >> 32)};
+        set_stream(stream());
+    }
+
+    /**
+     * set_stream - moves to the start of a stream, O(1).
+     */
+    void set_stream(std::uint64_t _stream) {
+        counter = {0, 0, static_cast<std::uint32_t>(_stream), static_cast<std::uint32_t>(_stream >> 32)};
+        position = 4;
+    }
+
+    std::uint64_t stream() const {
+        return static_cast<std::uint64_t>(counter[3]) << 32 | counter[2];
+    }
+
+    /**
+     * for_trial - the generator for trial (or worker) index of a run seeded with seed.
+     */
+    static Philox4x32 for_trial(std::uint64_t seed, std::uint64_t trial) {
+        return Philox4x32(seed, trial);
+    }
+
+    result_type operator()() {
+        if ( position == 4 ) {
+            generate_block();
+            increment_block();
+            position = 0;
+        }
+        return output[position++];
+    }
+
+    /**
+     * discard - advances by z values within the current stream, O(1).
+     */
+    void discard(unsigned long long z) {
+        std::uint64_t block = static_cast<std::uint64_t>(counter[1]) << 32 | counter[0];
+        // the values of the block before counter are in output; position 4 means none left
+        std::uint64_t next_value = (block - (position < 4 ? 1 : 0)) * 4 + (position < 4 ? position : 0) + z;
+        std::uint64_t target_block = next_value / 4;
+        int target_position = static_cast<int>(next_value % 4);
+        counter[0] = static_cast<std::uint32_t>(target_block);
+        counter[1] = static_cast<std::uint32_t>(target_block >> 32);
+        position = 4;
+        if ( target_position != 0 ) {
+            generate_block();
+            increment_block();
+            position = target_position;
+        }
+    }
+
+    friend bool operator==(const Philox4x32& a, const Philox4x32& b) {
+        return a.key == b.key && a.counter == b.counter && a.position == b.position
+               && (a.position == 4 || a.output == b.output);
+    }
+
+    friend std::ostream& operator<<(std::ostream& o, const Philox4x32& e) {
+        return o << e.key[0] << ' ' << e.key[1] << ' ' << e.counter[0] << ' ' << e.counter[1] << ' '
+                 << e.counter[2] << ' ' << e.counter[3] << ' ' << e.position;
+    }
+
+    /**
+     * Stream input, the output block is regenerated from the counter rather than stored.
+     */
+    friend std::istream& operator>>(std::istream& i, Philox4x32& e) {
+        i >> e.key[0] >> e.key[1] >> e.counter[0] >> e.counter[1]
+          >> e.counter[2] >> e.counter[3] >> e.position;
+        if ( e.position < 4 ) {
+            if ( e.counter[0]-- == 0 )
+                --e.counter[1];
+            e.generate_block();
+            e.increment_block();
+        }
+        return i;
+    }
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * splitmix64 - steps state and returns the next output, used to expand a 64-bit seed into the
+ * state of the larger generators.
+ */
+inline std::uint64_t splitmix64(std::uint64_t& state) {
+    std::uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+class Xoshiro256StarStar {
+public:
+    using result_type = std::uint64_t;
+
+private:
+    std::array<std::uint64_t, 4> s; ///> state, not all zero
+
+    static constexpr std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    explicit Xoshiro256StarStar(std::uint64_t _seed = 1) { seed(_seed); }
+
+    /**
+     * Xoshiro256StarStar constructor from a seed sequence (std::seed_seq), same as for the std engines.
+     */
+    template <class SEED_SEQ>
+        requires (!std::is_integral_v<SEED_SEQ>)
+    explicit Xoshiro256StarStar(SEED_SEQ& seed_sequence) {
+        std::array<std::uint32_t, 8> words;
+        seed_sequence.generate(words.begin(), words.end());
+        for ( int ix = 0; ix < 4; ++ix )
+            s[ix] = static_cast<std::uint64_t>(words[2 * ix + 1]) << 32 | words[2 * ix];
+        if ( s[0] == 0 && s[1] == 0 && s[2] == 0 && s[3] == 0 )
+            s[0] = 1;
+    }
+
+    void seed(std::uint64_t _seed) {
+        for ( std::uint64_t& word : s )
+            word = splitmix64(_seed);
+    }
+
+    result_type operator()() {
+        std::uint64_t result = rotl(s[1] * 5, 7) * 9;
+        std::uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    void discard(unsigned long long z) {
+        for ( ; z > 0; --z )
+            (*this)();
+    }
+
+    /**
+     * jump - advances by 2^128 values, as 2^128 calls of operator() would, at the cost of 256
+     * of them.
+     */
+    void jump() {
+        constexpr std::uint64_t polynomial[] = {0x180ec6d33cfd0aba, 0xd5a61266f0c9392c,
+                                                0xa9582618e03fc9aa, 0x39abdc4529b1661c};
+        std::array<std::uint64_t, 4> t = {0, 0, 0, 0};
+        for ( std::uint64_t word : polynomial )
+            for ( int bx = 0; bx < 64; ++bx ) {
+                if ( word & (std::uint64_t(1) << bx) )
+                    for ( int ix = 0; ix < 4; ++ix )
+                        t[ix] ^= s[ix];
+                (*this)();
+            }
+        s = t;
+    }
+
+    const std::array<std::uint64_t, 4>& state() const { return s; }
+
+    friend bool operator==(const Xoshiro256StarStar& a, const Xoshiro256StarStar& b) {
+        return a.s == b.s;
+    }
+
+    friend std::ostream& operator<<(std::ostream& o, const Xoshiro256StarStar& e) {
+        return o << e.s[0] << ' ' << e.s[1] << ' ' << e.s[2] << ' ' << e.s[3];
+    }
+
+    friend std::istream& operator>>(std::istream& i, Xoshiro256StarStar& e) {
+        return i >> e.s[0] >> e.s[1] >> e.s[2] >> e.s[3];
+    }
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+class PCG64 {
+public:
+    using result_type = std::uint64_t;
+
+private:
+    using uint128 = unsigned __int128;
+
+    static constexpr uint128 multiplier =
+            (static_cast<uint128>(0x2360ED051FC65DA4ULL) << 64) | 0x4385DF649FCCF645ULL;
+    static constexpr uint128 default_increment =
+            (static_cast<uint128>(0x5851F42D4C957F2DULL) << 64) | 0x14057B7EF767814FULL;
+
+    uint128 state;
+    uint128 increment; ///> odd, selects the stream
+
+    void step() { state = state * multiplier + increment; }
+
+    /**
+     * initialize - seeding of pcg-cpp, so that the values match its pcg64.
+     */
+    void initialize(uint128 _seed, uint128 _increment) {
+        increment = _increment | 1u;
+        state = 0;
+        step();
+        state += _seed;
+        step();
+    }
+
+public:
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    explicit PCG64(std::uint64_t _seed = 0xcafef00dd15ea5e5ULL) { initialize(_seed, default_increment); }
+
+    /**
+     * PCG64 constructor
+     * @param _seed initial state
+     * @param _stream selects one of 2^127 streams (e.g., worker index)
+     */
+    PCG64(std::uint64_t _seed, std::uint64_t _stream) {
+        initialize(_seed, static_cast<uint128>(_stream) << 1);
+    }
+
+    /**
+     * PCG64 constructor from a seed sequence (std::seed_seq), same as for the std engines.
+     */
+    template <class SEED_SEQ>
+        requires (!std::is_integral_v<SEED_SEQ>)
+    explicit PCG64(SEED_SEQ& seed_sequence) {
+        std::array<std::uint32_t, 8> words;
+        seed_sequence.generate(words.begin(), words.end());
+        uint128 seed_part = 0, stream_part = 0;
+        for ( int ix = 3; ix >= 0; --ix ) {
+            seed_part = (seed_part << 32) | words[ix];
+            stream_part = (stream_part << 32) | words[ix + 4];
+        }
+        initialize(seed_part, stream_part << 1);
+    }
+
+    void seed(std::uint64_t _seed) { initialize(_seed, default_increment); }
+
+    result_type operator()() {
+        step();
+        std::uint64_t folded = static_cast<std::uint64_t>(state >> 64) ^ static_cast<std::uint64_t>(state);
+        int rotation = static_cast<int>(state >> 122);
+        return (folded >> rotation) | (folded << ((-rotation) & 63));
+    }
+
+    /**
+     * discard - advances by z values in O(log z) (Brown, "Random number generation with
+     * arbitrary strides").
+     */
+    void discard(unsigned long long z) {
+        uint128 accumulated_multiplier = 1, accumulated_increment = 0;
+        uint128 current_multiplier = multiplier, current_increment = increment;
+        for ( ; z > 0; z >>= 1 ) {
+            if ( z & 1u ) {
+                accumulated_multiplier *= current_multiplier;
+                accumulated_increment = accumulated_increment * current_multiplier + current_increment;
+            }
+            current_increment = (current_multiplier + 1) * current_increment;
+            current_multiplier *= current_multiplier;
+        }
+        state = accumulated_multiplier * state + accumulated_increment;
+    }
+
+    friend bool operator==(const PCG64& a, const PCG64& b) {
+        return a.state == b.state && a.increment == b.increment;
+    }
+
+    friend std::ostream& operator<<(std::ostream& o, const PCG64& e) {
+        return o << static_cast<std::uint64_t>(e.state >> 64) << ' ' << static_cast<std::uint64_t>(e.state) << ' '
+                 << static_cast<std::uint64_t>(e.increment >> 64) << ' ' << static_cast<std::uint64_t>(e.increment);
+    }
+
+    friend std::istream& operator>>(std::istream& i, PCG64& e) {
+        std::uint64_t words[4];
+        i >> words[0] >> words[1] >> words[2] >> words[3];
+        e.state = static_cast<uint128>(words[0]) << 64 | words[1];
+        e.increment = static_cast<uint128>(words[2]) << 64 | words[3];
+        return i;
+    }
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * random_word - 64 uniformly distributed bits from any URBG, in one call if the engine gives
+ * 64 bits, in two if it gives 32.
+ */
+template <class URBG>
+inline std::uint64_t random_word(URBG& dre) {
+    using result_type = typename URBG::result_type;
+    constexpr std::uint64_t range = static_cast<std::uint64_t>(URBG::max() - URBG::min());
+    if constexpr ( range == std::numeric_limits<std::uint64_t>::max() )
+        return static_cast<std::uint64_t>(dre() - URBG::min());
+    else if constexpr ( range == 0xFFFFFFFFULL ) {
+        std::uint64_t high = static_cast<std::uint64_t>(static_cast<result_type>(dre() - URBG::min()));
+        return (high << 32) | static_cast<std::uint64_t>(static_cast<result_type>(dre() - URBG::min()));
+    }
+    else
+        return std::uniform_int_distribution<std::uint64_t>()(dre);
+}
+
+#endif //MONTECARLO_RANDOM_ENGINES_H
@@ -11,6 +11,9 @@
  * state's position in the StateMatrix's state vector. Note that i_min
  * should be zero and that i_max should be be one less than the length
  * of the transitions vector. Use case is DuellingIdiots/blind_spider_MCS.
+ * Transitions are equiprobable unless weights are given, in which case they are drawn from an
+ * alias table (O(1), one 64-bit word per step; see Alias_Table.h), so there is no need to
+ * repeat entries of the transitions vector to weight them.
  */
 
 #ifndef MONTECARLO_STATE_H
@@ -18,30 +21,54 @@
 
 #include <vector>
 #include <random>
+#include <ostream>
+#include <stdexcept>
+#include <val/montecarlo/Alias_Table.h>
 
 class State {
 public:
     int state_ID;
     std::vector<int> transitions; ///> Aligned with vector position in StateMatrix.
     std::uniform_int_distribution<int> uid; ///> Based on length of transitions.
+    Alias_Table weighted; ///> Empty for equiprobable transitions.
 
     State(int _state_ID,
             const std::vector<int>& _transitions)
             : state_ID(_state_ID), transitions(_transitions),
               uid(0, static_cast<int>(_transitions.size()-1)) {}
 
-    int get_next_state(std::default_random_engine& dre) {
+    /**
+     * State constructor with weighted transitions
+     * @param _transitions as above
+     * @param weights relative weight of each transition, aligned with _transitions
+     */
+    State(int _state_ID,
+            const std::vector<int>& _transitions,
+            const std::vector<double>& weights)
+            : state_ID(_state_ID), transitions(_transitions),
+              uid(0, static_cast<int>(_transitions.size()-1)), weighted(weights) {
+        if ( weights.size() != _transitions.size() )
+            throw std::invalid_argument("State: one weight per transition is needed");
+    }
+
+    template <class URBG>
+    int get_next_state(URBG& dre) {
+        if ( !weighted.empty() )
+            return transitions[weighted(dre)];
         return transitions[uid(dre)];
     }
 
-    friend std::ostream& operator << (std::ostream& o, State& s);
+    friend std::ostream& operator << (std::ostream& o, const State& s);
 };
 
-std::ostream& operator << (std::ostream& o, State& s) {
+inline std::ostream& operator << (std::ostream& o, const State& s) {
 
     o << s.state_ID << " - ";
-    for ( int tx_id : s.transitions )
-        o << tx_id << " ";
+    for ( std::size_t ix = 0; ix < s.transitions.size(); ++ix ) {
+        o << s.transitions[ix] << " ";
+        if ( !s.weighted.empty() )
+            o << "(" << s.weighted.get_probabilities()[ix] << ") ";
+    }
     o << '\n';
     return o;
 }
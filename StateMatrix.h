@@ -9,6 +9,8 @@
  * number of trials, a cumulative value, and contains a method for running
  * the simulation. An interesting detail is the separation of the default
  * random engine from the multiple distributions for the states.
+ * The engine is the template parameter of StateMatrix_T; StateMatrix keeps
+ * std::default_random_engine.
  * IMPORTANT: STATE NUMBERING MUST ALIGN WITH THE VECTOR POSITION OF THE
  * STATES.
  */
@@ -18,9 +20,17 @@
 
 #include <iostream>
 #include <vector>
+#include <algorithm>
 #include <val/montecarlo/State.h>
+#include <val/montecarlo/Checkpoint.h>
+#include <val/montecarlo/Instrumentation.h>
 
-class StateMatrix {
+/**
+ * StateMatrix_T - the random engine type is a template parameter (T -> template).
+ * @tparam ENGINE - UniformRandomBitGenerator, e.g., std::mt19937_64, PCG64, Xoshiro256StarStar
+ */
+template <class ENGINE>
+class StateMatrix_T {
 
     int nr_trials;
 
@@ -28,13 +38,15 @@ class StateMatrix {
     int initial_state; ///> holds initial state
     int absorbing_state; ///> holds final state
 
-    std::default_random_engine dre; ///> core random number generator
+    ENGINE dre; ///> core random number generator
 
     double cumulative_value; ///> Accumulates interim value
 
+    Instrumentation_Stats instrumentation; ///> filled by run if MONTECARLO_INSTRUMENT is defined
+
 public:
 
-    StateMatrix(int _nr_trials, std::vector<State>& _states, int _initial_state, int _absorbing_state) :
+    StateMatrix_T(int _nr_trials, std::vector<State>& _states, int _initial_state, int _absorbing_state) :
             nr_trials(_nr_trials),
             states(std::move(_states)),
             initial_state(_initial_state),
@@ -42,7 +54,25 @@ public:
             cumulative_value(0.0) {}
 
     void run() {
-
+#ifdef MONTECARLO_INSTRUMENT
+        Instrumented_Run instrumented_run(instrumentation, nr_trials);
+        Counting_Engine<ENGINE> counting_dre(dre);
+        for ( int ix = 0; ix < nr_trials; ++ix ) {
+            double interim_value = 0.0;
+            int current_state = initial_state;
+            std::uint64_t t0 = cycle_counter();
+            while ( current_state != absorbing_state ) {
+                current_state = states[current_state].get_next_state(counting_dre);
+                interim_value += 1.0;
+            }
+            std::uint64_t t1 = cycle_counter();
+            cumulative_value += interim_value;
+            std::uint64_t t2 = cycle_counter();
+            instrumentation.rng_cycles += t1 - t0;   ///> the walk is made of transition draws
+            instrumentation.accumulate_cycles += t2 - t1;
+        }
+        instrumentation.rng_draws = counting_dre.get_nr_draws();
+#else
         for ( int ix = 0; ix < nr_trials; ++ix ) {
             double interim_value = 0.0;
             int current_state = initial_state;
@@ -52,6 +82,45 @@ public:
             }
             cumulative_value += interim_value;
         }
+#endif
+    }
+
+    /**
+     * get_instrumentation - phase timings of the last run, all zero unless MONTECARLO_INSTRUMENT
+     * is defined (see Instrumentation.h).
+     */
+    const Instrumentation_Stats& get_instrumentation() const { return instrumentation; }
+
+    /**
+     * run_with_checkpoints - as run(), but saves the trial index, cumulative_value and dre every
+     * checkpoint.get_interval() trials, and resumes from the checkpoint file if it exists.
+     * @param checkpoint file, interval and attached objects
+     */
+    void run_with_checkpoints(Checkpoint& checkpoint) {
+        int ix = 0;
+        if ( checkpoint.exists() )
+            checkpoint.load([this, &ix](std::istream& i) {
+                read_binary(i, ix);
+                read_binary(i, cumulative_value);
+                read_stream_state(i, dre);
+            });
+        while ( ix < nr_trials ) {
+            int last = ix + std::min(checkpoint.get_interval(), nr_trials - ix);
+            for ( ; ix < last; ++ix ) {
+                double interim_value = 0.0;
+                int current_state = initial_state;
+                while ( current_state != absorbing_state ) {
+                    current_state = states[current_state].get_next_state(dre);
+                    interim_value += 1.0;
+                }
+                cumulative_value += interim_value;
+            }
+            checkpoint.save([this, ix](std::ostream& o) {
+                write_binary(o, ix);
+                write_binary(o, cumulative_value);
+                write_stream_state(o, dre);
+            });
+        }
     }
 
     void print_results() {
@@ -59,14 +128,14 @@ public:
                   << cumulative_value/static_cast<double>(nr_trials) << '\n';
     }
 
-    friend std::ostream& operator << (std::ostream& o, StateMatrix& sm);
-};
+    friend std::ostream& operator << (std::ostream& o, StateMatrix_T& sm) {
 
-std::ostream& operator << (std::ostream& o, StateMatrix& sm) {
+        for ( State& s : sm.states )
+            o << s;
+        return o;
+    }
+};
 
-    for ( State& s : sm.states )
-        o << s;
-    return o;
-}
+using StateMatrix = StateMatrix_T<std::default_random_engine>;
 
 #endif //MONTECARLO_STATEMATRIX_H
@@ -0,0 +1,198 @@
+/**
+ * \file Statistics.h
+ * \date 17-Oct-2026
+ *
+ * \brief Online (single pass) statistics of the per-trial values of a simulation.
+ *
+ * \details Running_Statistics uses Welford's update so that the mean and variance
+ * can be read at any point of a run without keeping the individual values. Two
+ * Running_Statistics can be merged (Chan et al.), e.g., after a parallel run.
+ * Running_Moments is the multivariate version, it also tracks the covariances
+ * between the components of a vector of values per trial.
+ */
+
+#ifndef MONTECARLO_STATISTICS_H
+#define MONTECARLO_STATISTICS_H
+
+#include <cmath>
+#include <utility>
+#include <algorithm>
+#include <span>
+#include <vector>
+
+class Running_Statistics {
+    long long n;        ///> number of values added
+    double mean_value;  ///> running mean
+    double m2;          ///> running sum of squared deviations from the mean
+public:
+
+    Running_Statistics() : n(0), mean_value(0.0), m2(0.0) {}
+
+    /**
+     * add - includes one value in the statistics.
+     * @param x value of one trial
+     */
+    void add(double x) {
+        ++n;
+        double delta = x - mean_value;
+        mean_value += delta / static_cast<double>(n);
+        m2 += delta * (x - mean_value);
+    }
+
+    /**
+     * merge - combines the statistics of another (disjoint) set of values into this one.
+     * @param other statistics of the other set
+     */
+    void merge(const Running_Statistics& other) {
+        if ( other.n == 0 ) return;
+        long long total = n + other.n;
+        double delta = other.mean_value - mean_value;
+        mean_value += delta * static_cast<double>(other.n) / static_cast<double>(total);
+        m2 += other.m2 + delta * delta * static_cast<double>(n) * static_cast<double>(other.n)
+                / static_cast<double>(total);
+        n = total;
+    }
+
+    long long count() const { return n; }
+    double mean() const { return mean_value; }
+
+    /**
+     * variance - unbiased (n-1) sample variance of the values, zero for fewer than two values.
+     */
+    double variance() const {
+        return n > 1 ? m2 / static_cast<double>(n - 1) : 0.0;
+    }
+
+    /**
+     * standard_error - estimated standard deviation of mean().
+     */
+    double standard_error() const {
+        return n > 0 ? std::sqrt(variance() / static_cast<double>(n)) : 0.0;
+    }
+};
+
+///-------------------------------------------------------------------------------------
+
+class Running_Moments {
+    long long n;                ///> number of vectors added
+    int dimension;              ///> number of components of each vector
+    std::vector<double> means;  ///> running mean of each component
+    std::vector<double> comoments; ///> dimension x dimension running sums of cross deviations
+    std::vector<double> delta;  ///> scratch, deviation from the prior mean
+public:
+
+    explicit Running_Moments(int _dimension = 0)
+            : n(0), dimension(_dimension), means(_dimension, 0.0),
+              comoments(static_cast<std::size_t>(_dimension) * _dimension, 0.0),
+              delta(_dimension, 0.0) {}
+
+    /**
+     * add - includes one vector of values (one value per component) in the moments.
+     * @param x values of one trial, x.size() == dimension
+     */
+    void add(std::span<const double> x) {
+        ++n;
+        double inverse_n = 1.0 / static_cast<double>(n);
+        for ( int ix = 0; ix < dimension; ++ix ) {
+            delta[ix] = x[ix] - means[ix];
+            means[ix] += delta[ix] * inverse_n;
+        }
+        for ( int ix = 0; ix < dimension; ++ix )
+            for ( int jx = 0; jx < dimension; ++jx )
+                comoments[ix * dimension + jx] += delta[ix] * (x[jx] - means[jx]);
+    }
+
+    /**
+     * merge - combines the moments of another (disjoint) set of vectors into this one.
+     * @param other moments of the other set, same dimension
+     */
+    void merge(const Running_Moments& other) {
+        if ( other.n == 0 ) return;
+        long long total = n + other.n;
+        double weight = static_cast<double>(n) * static_cast<double>(other.n) / static_cast<double>(total);
+        for ( int ix = 0; ix < dimension; ++ix )
+            delta[ix] = other.means[ix] - means[ix];
+        for ( int ix = 0; ix < dimension; ++ix )
+            for ( int jx = 0; jx < dimension; ++jx )
+                comoments[ix * dimension + jx] += other.comoments[ix * dimension + jx]
+                        + delta[ix] * delta[jx] * weight;
+        for ( int ix = 0; ix < dimension; ++ix )
+            means[ix] += delta[ix] * static_cast<double>(other.n) / static_cast<double>(total);
+        n = total;
+    }
+
+    long long count() const { return n; }
+    int size() const { return dimension; }
+    double mean(int ix) const { return means[ix]; }
+
+    /**
+     * covariance - unbiased (n-1) sample covariance of components ix and jx.
+     */
+    double covariance(int ix, int jx) const {
+        return n > 1 ? comoments[ix * dimension + jx] / static_cast<double>(n - 1) : 0.0;
+    }
+
+    double variance(int ix) const { return covariance(ix, ix); }
+
+    double standard_error(int ix) const {
+        return n > 0 ? std::sqrt(variance(ix) / static_cast<double>(n)) : 0.0;
+    }
+};
+
+/**
+ * regression_coefficients - least squares coefficients of component 0 on components 1..k of the
+ * moments, i.e., the solution of Cov(c,c) beta = Cov(c,y). These are the optimal control variate
+ * coefficients when component 0 is the trial value and 1..k the controls. Solved by Gaussian
+ * elimination with partial pivoting (k is small); a singular system gives zero coefficients
+ * for the dependent controls.
+ * @param moments Running_Moments with the trial value as component 0
+ * @return k coefficients
+ */
+inline std::vector<double> regression_coefficients(const Running_Moments& moments) {
+    int k = moments.size() - 1;
+    std::vector<double> a(static_cast<std::size_t>(k) * k);
+    std::vector<double> beta(k);
+    for ( int ix = 0; ix < k; ++ix ) {
+        for ( int jx = 0; jx < k; ++jx )
+            a[ix * k + jx] = moments.covariance(ix + 1, jx + 1);
+        beta[ix] = moments.covariance(ix + 1, 0);
+    }
+    double tolerance = 0.0; ///> pivots below this are treated as zero (dependent controls)
+    for ( int ix = 0; ix < k; ++ix )
+        tolerance = std::max(tolerance, 1e-12 * std::fabs(a[ix * k + ix]));
+    for ( int cx = 0; cx < k; ++cx ) {
+        int pivot = cx;
+        for ( int rx = cx + 1; rx < k; ++rx )
+            if ( std::fabs(a[rx * k + cx]) > std::fabs(a[pivot * k + cx]) )
+                pivot = rx;
+        if ( std::fabs(a[pivot * k + cx]) <= tolerance ) {
+            beta[cx] = 0.0;
+            for ( int rx = 0; rx < k; ++rx ) {
+                a[rx * k + cx] = 0.0;
+                a[cx * k + rx] = 0.0;
+            }
+            a[cx * k + cx] = 1.0;
+            continue;
+        }
+        if ( pivot != cx ) {
+            for ( int jx = 0; jx < k; ++jx )
+                std::swap(a[cx * k + jx], a[pivot * k + jx]);
+            std::swap(beta[cx], beta[pivot]);
+        }
+        for ( int rx = cx + 1; rx < k; ++rx ) {
+            double factor = a[rx * k + cx] / a[cx * k + cx];
+            for ( int jx = cx; jx < k; ++jx )
+                a[rx * k + jx] -= factor * a[cx * k + jx];
+            beta[rx] -= factor * beta[cx];
+        }
+    }
+    for ( int rx = k - 1; rx >= 0; --rx ) {
+        double value = beta[rx];
+        for ( int jx = rx + 1; jx < k; ++jx )
+            value -= a[rx * k + jx] * beta[jx];
+        beta[rx] = value / a[rx * k + rx];
+    }
+    return beta;
+}
+
+#endif //MONTECARLO_STATISTICS_H
@@ -0,0 +1,265 @@
+/**
+ * \file Trial_Sink.h
+ * \date 17-Oct-2026
+ *
+ * \brief Trial_Sink and Trial_Reader, a binary file of per-trial records (the trial value and,
+ * optionally, summaries of the trial's events) for offline analysis, e.g., of the tails.
+ *
+ * \details The trial loop only copies each record into an in-memory block; full blocks are
+ * handed to a background thread that writes them to the file, so the loop does not wait on
+ * the disk. A fixed number of blocks circulates between the two threads, i.e., the memory is
+ * bounded and the loop only stalls if the disk cannot keep up with it.
+ * The file is a 24-byte header (magic "MCTS", version, value type and size, record width)
+ * followed by the records, each record_width values of type T in native byte order.
+ * Trial_Reader checks the header against its T and reads the records back in chunks.
+ * Errors (cannot open, write or read) are reported as std::runtime_error; a write error of the
+ * background thread is rethrown by the next write or by close().
+ * Use case is MonteCarloSimulation::run_with_sink.
+ */
+
+#ifndef MONTECARLO_TRIAL_SINK_H
+#define MONTECARLO_TRIAL_SINK_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Trial_File_Header - first bytes of a trial file.
+ */
+struct Trial_File_Header {
+    static constexpr std::uint32_t file_magic = 0x5354434d; ///> "MCTS"
+    static constexpr std::uint32_t file_version = 1;
+
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t value_kind;   ///> 'f' floating point, 'i' signed, 'u' unsigned integral
+    std::uint32_t value_size;   ///> sizeof of a value
+    std::uint64_t record_width; ///> values per record
+
+    template <class T>
+    static std::uint32_t kind_of() {
+        return std::is_floating_point_v<T> ? 'f' : std::is_signed_v<T> ? 'i' : 'u';
+    }
+};
+
+template <class T>
+class Trial_Sink {
+    static_assert(std::is_arithmetic_v<T>, "Trial_Sink records arithmetic values");
+
+    std::FILE* file;
+    std::size_t record_width;   ///> values per record
+    std::size_t block_values;   ///> values per block (a whole number of records)
+
+    std::vector<T> current;     ///> block being filled by the trial loop
+    std::deque<std::vector<T>> full_blocks;  ///> waiting for the writer
+    std::vector<std::vector<T>> free_blocks; ///> written, ready for reuse
+    std::mutex mutex;
+    std::condition_variable block_ready;     ///> signals the writer
+    std::condition_variable block_free;      ///> signals the trial loop
+    bool closing;
+    std::exception_ptr writer_error;
+    std::uint64_t nr_values;    ///> values written so far
+    std::thread writer;
+
+    void write_blocks() {
+        std::unique_lock<std::mutex> lock(mutex);
+        for ( ;; ) {
+            block_ready.wait(lock, [this]() { return !full_blocks.empty() || closing; });
+            if ( full_blocks.empty() ) return;
+            std::vector<T> block = std::move(full_blocks.front());
+            full_blocks.pop_front();
+            lock.unlock();
+            bool written = std::fwrite(block.data(), sizeof(T), block.size(), file) == block.size();
+            lock.lock();
+            if ( !written && !writer_error )
+                writer_error = std::make_exception_ptr(std::runtime_error("Trial_Sink: cannot write the trial file"));
+            block.clear();
+            free_blocks.push_back(std::move(block));
+            block_free.notify_one();
+        }
+    }
+
+    /**
+     * submit - hands the current block to the writer and takes a free one, waiting for it if
+     * all blocks are in flight.
+     */
+    void submit() {
+        std::unique_lock<std::mutex> lock(mutex);
+        if ( writer_error ) std::rethrow_exception(writer_error);
+        full_blocks.push_back(std::move(current));
+        block_ready.notify_one();
+        block_free.wait(lock, [this]() { return !free_blocks.empty(); });
+        current = std::move(free_blocks.back());
+        free_blocks.pop_back();
+    }
+
+    /**
+     * open_trial_file - checks the record width before the file is created (truncated).
+     */
+    static std::FILE* open_trial_file(const std::string& path, std::size_t _record_width) {
+        if ( _record_width == 0 )
+            throw std::invalid_argument("Trial_Sink: the record width must be at least one value");
+        return std::fopen(path.c_str(), "wb");
+    }
+
+public:
+
+    /**
+     * Trial_Sink constructor - creates (truncates) the file and starts the writer thread.
+     * @param path trial file
+     * @param _record_width values per record, e.g., 1 for the trial value only; at least one
+     * (std::invalid_argument is thrown otherwise, as Trial_Reader rejects such a file)
+     * @param block_records records per block written at a time
+     * @param nr_blocks blocks in circulation, bounds the memory to nr_blocks * block_records records
+     */
+    explicit Trial_Sink(const std::string& path, std::size_t _record_width = 1,
+            std::size_t block_records = std::size_t(1) << 16, int nr_blocks = 4)
+            : file(open_trial_file(path, _record_width)), record_width(_record_width),
+              block_values(block_records * _record_width), closing(false), nr_values(0) {
+        if ( !file )
+            throw std::runtime_error("Trial_Sink: cannot open " + path);
+        Trial_File_Header header{Trial_File_Header::file_magic, Trial_File_Header::file_version,
+                                 Trial_File_Header::kind_of<T>(), sizeof(T), record_width};
+        if ( std::fwrite(&header, sizeof(header), 1, file) != 1 ) {
+            std::fclose(file);
+            throw std::runtime_error("Trial_Sink: cannot write " + path);
+        }
+        current.reserve(block_values);
+        for ( int bx = 1; bx < nr_blocks; ++bx ) {
+            free_blocks.emplace_back();
+            free_blocks.back().reserve(block_values);
+        }
+        writer = std::thread([this]() { write_blocks(); });
+    }
+
+    Trial_Sink(const Trial_Sink&) = delete;
+    Trial_Sink& operator=(const Trial_Sink&) = delete;
+
+    ~Trial_Sink() {
+        try {
+            close();
+        }
+        catch (...) {
+            // a destructor cannot report the error, call close() to see it
+        }
+    }
+
+    /**
+     * write - appends one record of record_width values.
+     */
+    void write(std::span<const T> record) {
+        current.insert(current.end(), record.begin(), record.end());
+        nr_values += record.size();
+        if ( current.size() >= block_values )
+            submit();
+    }
+
+    /**
+     * write - appends one value, the whole record when record_width is 1.
+     */
+    void write(T value) {
+        current.push_back(value);
+        ++nr_values;
+        if ( current.size() >= block_values )
+            submit();
+    }
+
+    std::size_t get_record_width() const { return record_width; }
+    std::uint64_t get_nr_records() const { return nr_values / record_width; }
+
+    /**
+     * close - writes the last, partial block, stops the writer and closes the file; further
+     * writes are not allowed.
+     */
+    void close() {
+        if ( !file ) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if ( !current.empty() )
+                full_blocks.push_back(std::move(current));
+            closing = true;
+        }
+        block_ready.notify_one();
+        writer.join();
+        bool closed = std::fclose(file) == 0;
+        file = nullptr;
+        if ( writer_error ) std::rethrow_exception(writer_error);
+        if ( !closed )
+            throw std::runtime_error("Trial_Sink: cannot close the trial file");
+    }
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+template <class T>
+class Trial_Reader {
+    std::FILE* file;
+    std::size_t record_width;
+    std::uint64_t nr_records;
+
+public:
+
+    /**
+     * Trial_Reader constructor - opens the file and checks that it holds values of type T.
+     * @param path trial file written by a Trial_Sink<T>
+     */
+    explicit Trial_Reader(const std::string& path) : file(std::fopen(path.c_str(), "rb")) {
+        if ( !file )
+            throw std::runtime_error("Trial_Reader: cannot open " + path);
+        Trial_File_Header header;
+        if ( std::fread(&header, sizeof(header), 1, file) != 1
+             || header.magic != Trial_File_Header::file_magic || header.version != Trial_File_Header::file_version
+             || header.value_kind != Trial_File_Header::kind_of<T>() || header.value_size != sizeof(T)
+             || header.record_width == 0 ) {
+            std::fclose(file);
+            throw std::runtime_error("Trial_Reader: " + path + " is not a trial file of this value type");
+        }
+        record_width = header.record_width;
+        std::fseek(file, 0, SEEK_END);
+        long size = std::ftell(file);
+        std::fseek(file, sizeof(header), SEEK_SET);
+        nr_records = (static_cast<std::uint64_t>(size) - sizeof(header)) / (sizeof(T) * record_width);
+    }
+
+    Trial_Reader(const Trial_Reader&) = delete;
+    Trial_Reader& operator=(const Trial_Reader&) = delete;
+
+    ~Trial_Reader() { std::fclose(file); }
+
+    std::size_t get_record_width() const { return record_width; }
+    std::uint64_t get_nr_records() const { return nr_records; }
+
+    /**
+     * read - the next records, as many whole records as fit in out.
+     * @return number of records read, 0 at the end of the file
+     */
+    std::size_t read(std::span<T> out) {
+        std::size_t wanted = out.size() / record_width;
+        std::size_t values = std::fread(out.data(), sizeof(T), wanted * record_width, file);
+        return values / record_width;
+    }
+
+    /**
+     * read_all - all (remaining) records, record_width values per record.
+     */
+    std::vector<T> read_all() {
+        std::vector<T> values(nr_records * record_width);
+        std::size_t nr_read = read(values);
+        values.resize(nr_read * record_width);
+        return values;
+    }
+};
+
+#endif //MONTECARLO_TRIAL_SINK_H
@@ -0,0 +1,259 @@
+/**
+ * \file Ziggurat.h
+ * \date 17-Oct-2026
+ *
+ * \brief Ziggurat_Normal_Distribution and Ziggurat_Exponential_Distribution, drop-in
+ * replacements of std::normal_distribution and std::exponential_distribution drawn with the
+ * ziggurat method (Marsaglia and Tsang, 2000), with a bulk fill from Bulk_Uniform_Generator.
+ *
+ * \details Both use 256 layers and one 64-bit word per draw: the low 8 bits select the layer,
+ * the top 53 bits give the position in it. About 99% of the draws are accepted right there
+ * with one multiplication and one comparison; only the rest evaluate exp (layer edges) or log
+ * (the tail beyond the base layer). Engines with fewer than 64 bits per call (e.g.,
+ * std::default_random_engine) are called as often as needed to make up a word.
+ * They have the interface of the standard distributions that Distribution and
+ * Distribution_NTT use (constructor from the parameters, operator()(URBG&), the parameter
+ * getters, min, max, reset), so they can be given as RANDOM_DIST / STD_DIST, e.g.,
+ * Distribution<double, double, Ziggurat_Exponential_Distribution>(lambda, nr_events).
+ * The values differ from those of the standard distributions for the same engine (the
+ * distribution is the same). antithetic_value and inverse_cdf are provided as for the
+ * standard ones, so mirror_random_values and the quasi-random runs work with them too, and
+ * stream operators for the parameters, so checkpointed runs do.
+ */
+
+#ifndef MONTECARLO_ZIGGURAT_H
+#define MONTECARLO_ZIGGURAT_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <val/montecarlo/Bulk_Uniform.h>
+#include <val/montecarlo/Inverse_Transform.h>
+
+/**
+ * Ziggurat_Tables - right edges x and densities f of the 256 layers of a ziggurat of equal areas
+ * under the (unnormalized) density f, x[0] being the width of the base layer's rectangle of
+ * the same area and x[256] = 0.
+ */
+struct Ziggurat_Tables {
+    static constexpr int nr_layers = 256;
+    std::array<double, nr_layers + 1> x;
+    std::array<double, nr_layers + 1> f;
+
+    /**
+     * Ziggurat_Tables constructor
+     * @param r right edge of the base layer (start of the tail)
+     * @param area area of each layer
+     * @param density unnormalized density, decreasing on [0, r]
+     * @param inverse_density its inverse
+     */
+    template <class DENSITY, class INVERSE>
+    Ziggurat_Tables(double r, double area, DENSITY density, INVERSE inverse_density) {
+        x[0] = area / density(r);
+        x[1] = r;
+        for ( int ix = 2; ix < nr_layers; ++ix )
+            x[ix] = inverse_density(area / x[ix - 1] + density(x[ix - 1]));
+        x[nr_layers] = 0.0;
+        for ( int ix = 0; ix <= nr_layers; ++ix )
+            f[ix] = density(x[ix]);
+    }
+};
+
+inline const Ziggurat_Tables ziggurat_normal_tables(3.6541528853610088, 0.00492867323399,
+        [](double x) { return std::exp(-0.5 * x * x); },
+        [](double y) { return std::sqrt(-2.0 * std::log(y)); });
+
+inline const Ziggurat_Tables ziggurat_exponential_tables(7.69711747013104972, 0.0039496598225815571993,
+        [](double x) { return std::exp(-x); },
+        [](double y) { return -std::log(y); });
+
+/**
+ * standard_normal_ziggurat - a standard normal value.
+ */
+template <class URBG>
+double standard_normal_ziggurat(URBG& dre) {
+    const Ziggurat_Tables& table = ziggurat_normal_tables;
+    for ( ;; ) {
+        std::uint64_t bits = random_word(dre);
+        int layer = static_cast<int>(bits & 0xFF);
+        double u = 2.0 * static_cast<double>(bits >> 11) * 0x1.0p-53 - 1.0;    ///> [-1, 1)
+        double x = u * table.x[layer];
+        if ( std::abs(x) < table.x[layer + 1] )
+            return x;
+        if ( layer == 0 ) {     ///> tail beyond r
+            double r = table.x[1];
+            double tail_x, tail_y;
+            do {
+                tail_x = std::log(static_cast<double>((random_word(dre) >> 11) + 1) * 0x1.0p-53) / r;
+                tail_y = std::log(static_cast<double>((random_word(dre) >> 11) + 1) * 0x1.0p-53);
+            } while ( -2.0 * tail_y < tail_x * tail_x );
+            return u < 0.0 ? tail_x - r : r - tail_x;
+        }
+        double v = static_cast<double>(random_word(dre) >> 11) * 0x1.0p-53;
+        if ( table.f[layer + 1] + v * (table.f[layer] - table.f[layer + 1]) < std::exp(-0.5 * x * x) )
+            return x;
+    }
+}
+
+/**
+ * standard_exponential_ziggurat - an exponential value of rate 1.
+ */
+template <class URBG>
+double standard_exponential_ziggurat(URBG& dre) {
+    const Ziggurat_Tables& table = ziggurat_exponential_tables;
+    for ( ;; ) {
+        std::uint64_t bits = random_word(dre);
+        int layer = static_cast<int>(bits & 0xFF);
+        double x = static_cast<double>(bits >> 11) * 0x1.0p-53 * table.x[layer];
+        if ( x < table.x[layer + 1] )
+            return x;
+        if ( layer == 0 )       ///> memoryless tail beyond r
+            return table.x[1] - std::log(static_cast<double>((random_word(dre) >> 11) + 1) * 0x1.0p-53);
+        double v = static_cast<double>(random_word(dre) >> 11) * 0x1.0p-53;
+        if ( table.f[layer + 1] + v * (table.f[layer] - table.f[layer + 1]) < std::exp(-x) )
+            return x;
+    }
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+template <class RealType = double>
+class Ziggurat_Normal_Distribution {
+    RealType mean_value;
+    RealType stddev_value;
+public:
+    using result_type = RealType;
+
+    explicit Ziggurat_Normal_Distribution(RealType _mean = 0.0, RealType _stddev = 1.0)
+            : mean_value(_mean), stddev_value(_stddev) {}
+
+    template <class URBG>
+    result_type operator()(URBG& dre) {
+        return mean_value + stddev_value * static_cast<RealType>(standard_normal_ziggurat(dre));
+    }
+
+    RealType mean() const { return mean_value; }
+    RealType stddev() const { return stddev_value; }
+    result_type min() const { return std::numeric_limits<RealType>::lowest(); }
+    result_type max() const { return std::numeric_limits<RealType>::max(); }
+    void reset() {}
+
+    friend bool operator==(const Ziggurat_Normal_Distribution& a, const Ziggurat_Normal_Distribution& b) {
+        return a.mean_value == b.mean_value && a.stddev_value == b.stddev_value;
+    }
+
+    /**
+     * stream operators - the parameters, as for std::normal_distribution (the ziggurat keeps no
+     * other state), so that write_state/read_state and checkpoints work.
+     */
+    friend std::ostream& operator<<(std::ostream& o, const Ziggurat_Normal_Distribution& d) {
+        std::ios_base::fmtflags flags = o.flags(std::ios_base::scientific);
+        std::streamsize precision = o.precision(std::numeric_limits<RealType>::max_digits10);
+        o << d.mean_value << ' ' << d.stddev_value;
+        o.flags(flags);
+        o.precision(precision);
+        return o;
+    }
+
+    friend std::istream& operator>>(std::istream& i, Ziggurat_Normal_Distribution& d) {
+        RealType _mean, _stddev;
+        if ( i >> _mean >> _stddev )
+            d = Ziggurat_Normal_Distribution(_mean, _stddev);
+        return i;
+    }
+};
+
+template <class RealType = double>
+class Ziggurat_Exponential_Distribution {
+    RealType lambda_value;
+public:
+    using result_type = RealType;
+
+    explicit Ziggurat_Exponential_Distribution(RealType _lambda = 1.0) : lambda_value(_lambda) {}
+
+    template <class URBG>
+    result_type operator()(URBG& dre) {
+        return static_cast<RealType>(standard_exponential_ziggurat(dre)) / lambda_value;
+    }
+
+    RealType lambda() const { return lambda_value; }
+    result_type min() const { return RealType(0); }
+    result_type max() const { return std::numeric_limits<RealType>::max(); }
+    void reset() {}
+
+    friend bool operator==(const Ziggurat_Exponential_Distribution& a, const Ziggurat_Exponential_Distribution& b) {
+        return a.lambda_value == b.lambda_value;
+    }
+
+    friend std::ostream& operator<<(std::ostream& o, const Ziggurat_Exponential_Distribution& d) {
+        std::ios_base::fmtflags flags = o.flags(std::ios_base::scientific);
+        std::streamsize precision = o.precision(std::numeric_limits<RealType>::max_digits10);
+        o << d.lambda_value;
+        o.flags(flags);
+        o.precision(precision);
+        return o;
+    }
+
+    friend std::istream& operator>>(std::istream& i, Ziggurat_Exponential_Distribution& d) {
+        RealType _lambda;
+        if ( i >> _lambda )
+            d = Ziggurat_Exponential_Distribution(_lambda);
+        return i;
+    }
+};
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+/**
+ * fill_distribution - bulk fills for the ziggurat distributions (see Bulk_Uniform.h). The
+ * words left in the stream's buffer at the end of a fill are discarded.
+ */
+template <class T>
+void fill_distribution(Bulk_Uniform_Generator& generator, const Ziggurat_Normal_Distribution<T>& distribution,
+        T* out, std::size_t n) {
+    Bulk_Word_Stream words(generator);
+    for ( std::size_t ix = 0; ix < n; ++ix )
+        out[ix] = distribution.mean() + distribution.stddev() * static_cast<T>(standard_normal_ziggurat(words));
+}
+
+template <class T>
+void fill_distribution(Bulk_Uniform_Generator& generator, const Ziggurat_Exponential_Distribution<T>& distribution,
+        T* out, std::size_t n) {
+    Bulk_Word_Stream words(generator);
+    for ( std::size_t ix = 0; ix < n; ++ix )
+        out[ix] = static_cast<T>(standard_exponential_ziggurat(words)) / distribution.lambda();
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+template <class T>
+T antithetic_value(const Ziggurat_Normal_Distribution<T>& distribution, T x) {
+    return distribution.mean() + distribution.mean() - x;
+}
+
+template <class T>
+T antithetic_value(const Ziggurat_Exponential_Distribution<T>& distribution, T x) {
+    T u = -std::expm1(-distribution.lambda() * x);
+    if ( u <= T(0) ) return std::numeric_limits<T>::max();
+    return -std::log(u) / distribution.lambda();
+}
+
+template <class T>
+T inverse_cdf(const Ziggurat_Normal_Distribution<T>& distribution, double u) {
+    return distribution.mean() + distribution.stddev() * static_cast<T>(standard_normal_quantile(u));
+}
+
+template <class T>
+T inverse_cdf(const Ziggurat_Exponential_Distribution<T>& distribution, double u) {
+    return static_cast<T>(-std::log1p(-u)) / distribution.lambda();
+}
+
+#endif //MONTECARLO_ZIGGURAT_H